@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AIDecisionSubsystem.h"
+
+#include "Async/ParallelFor.h"
+
+#include "RC/AI/BaseAIController.h"
+#include "RC/Debug/Debug.h"
+
+const float UAIDecisionSubsystem::DecisionInterval = 0.2f;
+
+// Run the decision pass
+void UAIDecisionSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceDecision += DeltaTime;
+	if (TimeSinceDecision < DecisionInterval)
+	{
+		return;
+	}
+	TimeSinceDecision = 0.0f;
+
+	// Snapshot everyone on the game thread
+	Snapshots.Reset();
+	for (int32 Index = Controllers.Num() - 1; Index >= 0; --Index)
+	{
+		if (!IsValid(Controllers[Index]))
+		{
+			Controllers.RemoveAt(Index);
+		}
+	}
+	Snapshots.SetNum(Controllers.Num());
+	for (int32 Index = 0; Index < Controllers.Num(); ++Index)
+	{
+		Controllers[Index]->FillDecisionSnapshot(Snapshots[Index]);
+	}
+
+	// Score off the game thread, each result only depends on its own snapshot
+	ChosenStates.SetNum(Snapshots.Num());
+	ParallelFor(Snapshots.Num(), [this](int32 Index)
+	{
+		ChosenStates[Index] = ChooseState(Snapshots[Index]);
+	});
+
+	// Apply in order back on the game thread
+	for (int32 Index = 0; Index < Controllers.Num(); ++Index)
+	{
+		ABaseAIController* Controller = Controllers[Index];
+		if (ChosenStates[Index] != Snapshots[Index].CurrentState && Controller->CanMakeDecisions())
+		{
+			Controller->RequestState(ChosenStates[Index]);
+		}
+	}
+}
+
+// Add a controller to the decision pass
+void UAIDecisionSubsystem::RegisterController(ABaseAIController* Controller)
+{
+	ASSERT_RETURN(Controller != nullptr);
+	Controllers.AddUnique(Controller);
+}
+
+// Remove a controller from the decision pass
+void UAIDecisionSubsystem::UnregisterController(ABaseAIController* Controller)
+{
+	Controllers.Remove(Controller);
+}
+
+// Score the candidate states for a snapshot
+EAIState UAIDecisionSubsystem::ChooseState(const FAIDecisionSnapshot& Snapshot)
+{
+	const FAIUtilitySettings& Settings = Snapshot.Settings;
+	const float DistanceSqr = FVector::DistSquared(Snapshot.Location, Snapshot.PlayerLocation);
+	const bool bHasSeenPlayer = Snapshot.TimeSinceSeenPlayer >= 0.0f;
+
+	// Less eager to engage when hurt
+	const float Aggression = FMath::Lerp(Settings.LowHealthAggression, 1.0f, FMath::Clamp(Snapshot.HealthFraction, 0.0f, 1.0f));
+
+	float CombatScore = 0.0f;
+	float ChaseScore = 0.0f;
+	float SearchScore = 0.0f;
+	const float DefaultScore = 0.2f;
+	if (Snapshot.bCanSeePlayer)
+	{
+		if (DistanceSqr <= FMath::Square(Settings.CombatRange))
+		{
+			CombatScore = 1.0f * Aggression;
+		}
+		ChaseScore = 0.8f * Aggression;
+	}
+	else if (bHasSeenPlayer)
+	{
+		if (Snapshot.TimeSinceSeenPlayer <= Settings.ChaseMemory)
+		{
+			ChaseScore = 0.6f * Aggression;
+		}
+		if (Snapshot.TimeSinceSeenPlayer <= Settings.SearchMemory)
+		{
+			SearchScore = 0.4f;
+		}
+	}
+
+	// Fight back when recently damaged, even without seeing who did it
+	if (Snapshot.TimeSinceDamaged >= 0.0f && Snapshot.TimeSinceDamaged <= Settings.DamagedMemory)
+	{
+		CombatScore = FMath::Max(CombatScore, 1.0f * Aggression);
+	}
+
+	// Ties go to the earlier candidate so the result is stable
+	EAIState BestState = Snapshot.DefaultState;
+	float BestScore = DefaultScore;
+	const TPair<EAIState, float> Candidates[] =
+	{
+		TPair<EAIState, float>(EAIState::Combat, CombatScore),
+		TPair<EAIState, float>(EAIState::Chase, ChaseScore),
+		TPair<EAIState, float>(EAIState::Search, SearchScore),
+	};
+	for (const TPair<EAIState, float>& Candidate : Candidates)
+	{
+		if (Candidate.Value > BestScore)
+		{
+			BestScore = Candidate.Value;
+			BestState = Candidate.Key;
+		}
+	}
+	return BestState;
+}
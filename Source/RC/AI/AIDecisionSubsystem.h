@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RC/Util/RCTypes.h"
+
+#include "AIDecisionSubsystem.generated.h"
+
+/**
+ * Tuning for scoring which state an AI should be in
+ */
+USTRUCT(BlueprintType)
+struct FAIUtilitySettings
+{
+	GENERATED_BODY()
+
+	// Distance to the player within which the AI wants to fight if it can see them
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	float CombatRange = 1200.0f;
+
+	// How long after losing sight of the player the AI still chases
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	float ChaseMemory = 2.0f;
+
+	// How long after losing sight of the player the AI still searches
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	float SearchMemory = 8.0f;
+
+	// How long after being damaged the AI wants to fight back
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	float DamagedMemory = 3.0f;
+
+	// How aggressive the AI is at no health, scaling up to fully aggressive at full health
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float LowHealthAggression = 0.5f;
+};
+
+/**
+ * Read only inputs for scoring a single AI's state
+ */
+struct FAIDecisionSnapshot
+{
+	// Location of the AI
+	FVector Location = FVector::ZeroVector;
+
+	// Location of the player
+	FVector PlayerLocation = FVector::ZeroVector;
+
+	// Health of the AI as a fraction of its max
+	float HealthFraction = 1.0f;
+
+	// Time since the AI last saw the player, negative if it never has
+	float TimeSinceSeenPlayer = -1.0f;
+
+	// Time since the AI was last damaged, negative if it never has been
+	float TimeSinceDamaged = -1.0f;
+
+	// Whether the AI can currently see the player
+	bool bCanSeePlayer = false;
+
+	// The state the AI is in
+	EAIState CurrentState = EAIState::NUM_STATES;
+
+	// The state the AI falls back to when it has nothing to do
+	EAIState DefaultState = EAIState::Idle;
+
+	// The AI's tuning
+	FAIUtilitySettings Settings;
+};
+
+/**
+ * Evaluates the state of every opted in AI in one pass.
+ * Inputs are snapshotted on the game thread, scored in parallel, then the state requests are applied back on the game thread in order
+ */
+UCLASS()
+class RC_API UAIDecisionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// FTickableGameObject implementation Begin
+	// Whether this subsystem should tick
+	virtual bool IsTickable() const override { return Controllers.Num() != 0 && Super::IsTickable(); }
+
+	// Run the decision pass
+	virtual void Tick(float DeltaTime) override;
+
+	// Needed for tickables
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UAIDecisionSubsystem, STATGROUP_Tickables); }
+	// FTickableGameObject implementation End
+
+	// Add a controller to the decision pass
+	void RegisterController(class ABaseAIController* Controller);
+
+	// Remove a controller from the decision pass
+	void UnregisterController(class ABaseAIController* Controller);
+
+	/**
+	 * Score the candidate states for a snapshot
+	 * Only depends on the snapshot so the same snapshot will always choose the same state
+	 *
+	 * @param Snapshot	The AI's inputs
+	 * Returns the best state
+	 */
+	static EAIState ChooseState(const FAIDecisionSnapshot& Snapshot);
+
+private:
+	// Time between decision passes
+	static const float DecisionInterval;
+
+	// Controllers taking part in the decision pass
+	UPROPERTY()
+	TArray<class ABaseAIController*> Controllers;
+
+	// Snapshots for the current pass, kept around to avoid reallocating
+	TArray<FAIDecisionSnapshot> Snapshots;
+
+	// Chosen states for the current pass
+	TArray<EAIState> ChosenStates;
+
+	// Time since the last pass
+	float TimeSinceDecision = 0.0f;
+};
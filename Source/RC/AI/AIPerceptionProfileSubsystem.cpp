@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "AIPerceptionProfileSubsystem.h"
+
+#include "Perception/AISenseConfig_Sight.h"
+
+#include "RC/AI/BaseAIController.h"
+#include "RC/Debug/Debug.h"
+
+// Get the sight config for a profile, creating the configs for the controller's class if needed
+UAISenseConfig_Sight* UAIPerceptionProfileSubsystem::GetSightConfig(const ABaseAIController& Controller, EAIPerceptionProfile Profile)
+{
+	ASSERT_RETURN_VALUE(Profile < EAIPerceptionProfile::NUM_PROFILES, nullptr);
+
+	UClass* ControllerClass = Controller.GetClass();
+	FAIPerceptionProfiles* Profiles = ClassProfiles.Find(ControllerClass);
+	if (Profiles == nullptr)
+	{
+		// Let the class defaults fill out the configs so every instance gets the same values
+		const ABaseAIController* DefaultController = ControllerClass->GetDefaultObject<ABaseAIController>();
+		ASSERT_RETURN_VALUE(DefaultController != nullptr, nullptr);
+
+		Profiles = &ClassProfiles.Add(ControllerClass);
+		for (uint8 ProfileIndex = 0; ProfileIndex < static_cast<uint8>(EAIPerceptionProfile::NUM_PROFILES); ++ProfileIndex)
+		{
+			UAISenseConfig_Sight* SightConfig = NewObject<UAISenseConfig_Sight>(this);
+			DefaultController->SetupSightProfile(static_cast<EAIPerceptionProfile>(ProfileIndex), *SightConfig);
+			Profiles->SightConfigs.Add(SightConfig);
+		}
+	}
+
+	return Profiles->SightConfigs[static_cast<uint8>(Profile)];
+}
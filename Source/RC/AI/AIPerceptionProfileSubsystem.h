@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RC/Util/RCTypes.h"
+
+#include "AIPerceptionProfileSubsystem.generated.h"
+
+/**
+ * The sense configs for each perception profile of a controller class
+ */
+USTRUCT()
+struct FAIPerceptionProfiles
+{
+	GENERATED_BODY()
+
+	// Sight config for each profile, indexed by EAIPerceptionProfile
+	UPROPERTY()
+	TArray<class UAISenseConfig_Sight*> SightConfigs;
+};
+
+/**
+ * Creates the sense configs of each perception profile once per controller class.
+ * Every controller of a class in the same profile shares the same config, so switching profile only swaps which config is used
+ */
+UCLASS()
+class RC_API UAIPerceptionProfileSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Get the sight config for a profile, creating the configs for the controller's class if needed
+	 *
+	 * @param Controller	The controller to get the config for
+	 * @param Profile		The profile to get
+	 * Returns the shared sight config
+	 */
+	class UAISenseConfig_Sight* GetSightConfig(const class ABaseAIController& Controller, EAIPerceptionProfile Profile);
+
+private:
+	// Profiles of each controller class
+	UPROPERTY()
+	TMap<UClass*, FAIPerceptionProfiles> ClassProfiles;
+};
@@ -16,6 +16,8 @@
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 #include "Runtime/Engine/Classes/Engine/World.h"
 
+#include "RC/AI/AIPerceptionProfileSubsystem.h"
+#include "RC/Characters/Components/HealthComponent.h"
 #include "RC/Characters/Enemies/BaseEnemy.h"
 #include "RC/AI/BlackBoardKeys.h"
 #include "RC/Debug/Debug.h"
@@ -41,13 +43,34 @@ void ABaseAIController::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Configure perception before the tree starts so its first tick sees with the right profile
+	CurrentState = DefaultState;
+	UpdatePerceptionProfile();
+
 	// Setup behavior tree
 	ASSERT_RETURN(BehaviorTree != nullptr);
 	ASSERT_RETURN(RunBehaviorTree(BehaviorTree));
 
-	CurrentState = DefaultState;
-
 	SetupStateTransitions();
+
+	if (bUseUtilityDecisions)
+	{
+		UAIDecisionSubsystem* DecisionSubsystem = GetWorld()->GetSubsystem<UAIDecisionSubsystem>();
+		ASSERT_RETURN(DecisionSubsystem != nullptr);
+		DecisionSubsystem->RegisterController(this);
+	}
+}
+
+// Called when the controller is being removed
+void ABaseAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UAIDecisionSubsystem* DecisionSubsystem = GetWorld() != nullptr ? GetWorld()->GetSubsystem<UAIDecisionSubsystem>() : nullptr;
+	if (DecisionSubsystem != nullptr)
+	{
+		DecisionSubsystem->UnregisterController(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // When this controller is asked to possess a pawn
@@ -126,6 +149,100 @@ void ABaseAIController::UnstunAI()
 	RequestState(PreviousState);
 }
 
+// Put the AI back into its default state, forgetting anything it's perceived and clearing the blackboard
+void ABaseAIController::ResetAI()
+{
+	ASSERT_RETURN(BlackboardComponent != nullptr);
+
+	UAIPerceptionComponent* Perception = GetPerceptionComponent();
+	if (Perception != nullptr)
+	{
+		Perception->ForgetAll();
+	}
+
+	// SelfActor is set once when the blackboard is initialized, so keep it
+	const FBlackboard::FKey SelfActorKeyID = BlackboardComponent->GetKeyID(FBlackboard::KeySelf);
+	for (FBlackboard::FKey KeyID = 0; KeyID < BlackboardComponent->GetNumKeys(); ++KeyID)
+	{
+		if (KeyID != SelfActorKeyID)
+		{
+			BlackboardComponent->ClearValue(KeyID);
+		}
+	}
+
+	bStunned = false;
+	bCanSeePlayer = false;
+	LastSeenPlayerTime = -1.0f;
+	LastDamagedTime = -1.0f;
+	RequestedState = EAIState::NUM_STATES;
+	PreviousState = EAIState::NUM_STATES;
+	CurrentState = DefaultState;
+
+	BlackboardComponent->SetValue<UBlackboardKeyType_Enum>(CurrentStateKey.GetSelectedKeyID(), static_cast<UBlackboardKeyType_Enum::FDataType>(CurrentState));
+	BlackboardComponent->SetValue<UBlackboardKeyType_Enum>(RequestedStateKey.GetSelectedKeyID(), static_cast<UBlackboardKeyType_Enum::FDataType>(RequestedState));
+
+	// The blackboard was cleared so the profile needs applying again
+	PerceptionProfile = EAIPerceptionProfile::NUM_PROFILES;
+	UpdatePerceptionProfile();
+}
+
+// Fill out the inputs for the AI decision pass
+void ABaseAIController::FillDecisionSnapshot(FAIDecisionSnapshot& Snapshot) const
+{
+	Snapshot.CurrentState = CurrentState;
+	Snapshot.DefaultState = DefaultState;
+	Snapshot.Settings = UtilitySettings;
+	Snapshot.bCanSeePlayer = bCanSeePlayer;
+	Snapshot.TimeSinceSeenPlayer = LastSeenPlayerTime >= 0.0f ? GetWorld()->GetTimeSeconds() - LastSeenPlayerTime : -1.0f;
+	Snapshot.TimeSinceDamaged = LastDamagedTime >= 0.0f ? GetWorld()->GetTimeSeconds() - LastDamagedTime : -1.0f;
+
+	APawn* ControlledPawn = GetPawn();
+	Snapshot.Location = ControlledPawn != nullptr ? ControlledPawn->GetActorLocation() : FVector::ZeroVector;
+
+	ABaseCharacter* Character = Cast<ABaseCharacter>(ControlledPawn);
+	Snapshot.HealthFraction = Character != nullptr && Character->GetHealth() != nullptr ? Character->GetHealth()->GetHealthFraction() : 1.0f;
+
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	Snapshot.PlayerLocation = Player != nullptr ? Player->GetActorLocation() : FVector::ZeroVector;
+}
+
+// Whether the decision pass can change this AI's state
+bool ABaseAIController::CanMakeDecisions() const
+{
+	if (!bAIActive || bStunned || RequestedState != EAIState::NUM_STATES)
+	{
+		return false;
+	}
+
+	ABaseCharacter* Character = GetPawn<ABaseCharacter>();
+	return Character != nullptr && !Character->IsDead();
+}
+
+// Set whether the AI is running its logic and reacting to perception
+void ABaseAIController::SetAIActive(bool bActive)
+{
+	bAIActive = bActive;
+
+	StopMovement();
+	if (bActive)
+	{
+		StartLogic();
+	}
+	else if (BehaviorTreeComponent != nullptr)
+	{
+		BehaviorTreeComponent->StopLogic(TEXT("Deactivated"));
+	}
+}
+
+// Start the AI's logic running again when it's activated
+void ABaseAIController::StartLogic()
+{
+	if (BehaviorTreeComponent != nullptr)
+	{
+		BehaviorTreeComponent->RestartLogic();
+	}
+}
+
 // Return the blackboard asset
 UBlackboardData* ABaseAIController::GetBlackboardAsset() const
 {
@@ -180,12 +297,12 @@ void ABaseAIController::SetupStateTransitions()
 	 * Example map adding
 	 * TNewStateChangeFunctionMap ChaseMap;
 	 * ChaseMap.Emplace(EAIState::Patrol, new FStateChangePredicate<ABaseAIController>(this, &ABaseAIController::test1));
-	 * StateTransitions.Emplace(EAIState::Combat, new FStateTransition<ABaseAIController>(this, &ABaseAIController::UpdatePerceptionSight, ChaseMap, &ABaseAIController::UpdatePerceptionSight));
+	 * StateTransitions.Emplace(EAIState::Combat, new FStateTransition<ABaseAIController>(this, &ABaseAIController::UpdatePerceptionProfile, ChaseMap, &ABaseAIController::UpdatePerceptionProfile));
 	 */
 	
 	// Have the sight perception configs get updated when going into/outof these states
-	StateTransitions.Emplace(EAIState::Combat, new FStateTransition<ABaseAIController>(this, &ABaseAIController::UpdatePerceptionSight, &ABaseAIController::UpdatePerceptionSight));
-	StateTransitions.Emplace(EAIState::Chase, new FStateTransition<ABaseAIController>(this, &ABaseAIController::UpdatePerceptionSight, &ABaseAIController::UpdatePerceptionSight));
+	StateTransitions.Emplace(EAIState::Combat, new FStateTransition<ABaseAIController>(this, &ABaseAIController::UpdatePerceptionProfile, &ABaseAIController::UpdatePerceptionProfile));
+	StateTransitions.Emplace(EAIState::Chase, new FStateTransition<ABaseAIController>(this, &ABaseAIController::UpdatePerceptionProfile, &ABaseAIController::UpdatePerceptionProfile));
 }
 
 // Send off events for behavior tree nodes that the state change has finished
@@ -226,6 +343,12 @@ void ABaseAIController::FinishStateChange()
 // When a target has been detected through stimulus
 void ABaseAIController::OnTargetDetected(AActor* DetectedActor, const FAIStimulus stimulus)
 {
+	// Not running
+	if (!bAIActive)
+	{
+		return;
+	}
+
 	// Update last detected actor
 	if (stimulus.WasSuccessfullySensed())
 	{
@@ -237,7 +360,14 @@ void ABaseAIController::OnTargetDetected(AActor* DetectedActor, const FAIStimulu
 	{		
 		if (stimulus.WasSuccessfullySensed())
 		{
-			RequestState(EAIState::Combat);
+			// The decision pass chooses the state if it's in use
+			if (!bUseUtilityDecisions)
+			{
+				RequestState(EAIState::Combat);
+			}
+
+			// Track for the decision pass
+			LastDamagedTime = GetWorld()->GetTimeSeconds();
 		}
 	}
 	else if (stimulus.Type == UAISense::GetSenseID<UAISense_Sight>())
@@ -246,15 +376,16 @@ void ABaseAIController::OnTargetDetected(AActor* DetectedActor, const FAIStimulu
 		ARCCharacter* Player = Cast<ARCCharacter>(DetectedActor);
 		if (Player != nullptr)
 		{
-			if (stimulus.WasSuccessfullySensed())
-			{
-				RequestState(EAIState::Combat);
-			}
-			else
+			// The decision pass chooses the state if it's in use
+			if (!bUseUtilityDecisions)
 			{
-				RequestState(EAIState::Search);
+				RequestState(stimulus.WasSuccessfullySensed() ? EAIState::Combat : EAIState::Search);
 			}
 			GetBlackBoard()->SetValueAsBool(BlackBoardKeys::CAN_SEE_PLAYER, stimulus.WasSuccessfullySensed());
+
+			// Track for the decision pass
+			bCanSeePlayer = stimulus.WasSuccessfullySensed();
+			LastSeenPlayerTime = GetWorld()->GetTimeSeconds();
 		}
 	}
 }
@@ -262,56 +393,79 @@ void ABaseAIController::OnTargetDetected(AActor* DetectedActor, const FAIStimulu
 // Setup perception configs
 void ABaseAIController::SetupPerception()
 {
-	// Create and initialize sight configuration object
 	UAIPerceptionComponent* Perception = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("Perception Component"));
 	ASSERT_RETURN(Perception != nullptr);
 	SetPerceptionComponent(*Perception);
 
-	SightConfig = CreateDefaultSubobject<UAISenseConfig_Sight>(TEXT("Sight Config"));
-	ASSERT_RETURN(SightConfig != nullptr);
-	SightConfig->SightRadius = 800.f;
-	SightConfig->LoseSightRadius = SightConfig->SightRadius + 50.f;
-	SightConfig->PeripheralVisionAngleDegrees = 75.f;
-	SightConfig->SetMaxAge(5.f);
-	SightConfig->DetectionByAffiliation.bDetectEnemies = true;
-	SightConfig->DetectionByAffiliation.bDetectFriendlies = true;
-	SightConfig->DetectionByAffiliation.bDetectNeutrals = true;
-
 	DamageConfig = CreateDefaultSubobject<UAISenseConfig_Damage>(TEXT("Damage Config"));
 	ASSERT_RETURN(DamageConfig != nullptr);
 
 	// Add config to component
-	// Updating the sight will configure it
-	UpdatePerceptionSight();
+	// Sight is configured from the shared profiles once playing
 	Perception->ConfigureSense(*DamageConfig);
 	Perception->OnTargetPerceptionUpdated.AddDynamic(this, &ABaseAIController::OnTargetDetected);
 }
 
-// Update the perception sight configs
-void ABaseAIController::UpdatePerceptionSight()
+// Fill out the sight config for a perception profile
+void ABaseAIController::SetupSightProfile(EAIPerceptionProfile Profile, UAISenseConfig_Sight& SightConfig) const
 {
-	UAIPerceptionComponent* Perception = GetPerceptionComponent();
-	ASSERT_RETURN(Perception != nullptr);
+	SightConfig.PeripheralVisionAngleDegrees = 75.f;
+	SightConfig.SetMaxAge(5.f);
+	SightConfig.DetectionByAffiliation.bDetectEnemies = true;
+	SightConfig.DetectionByAffiliation.bDetectFriendlies = true;
+	SightConfig.DetectionByAffiliation.bDetectNeutrals = true;
 
-	switch (CurrentState)
+	switch (Profile)
 	{
-		case EAIState::Idle:
-		case EAIState::Patrol:
-		case EAIState::Search:
-		case EAIState::NUM_STATES:
-			SightConfig->SightRadius = 800.f;
-			SightConfig->LoseSightRadius = SightConfig->SightRadius + 50.f;
+		case EAIPerceptionProfile::Patrol:
+			SightConfig.SightRadius = 800.f;
+			SightConfig.LoseSightRadius = SightConfig.SightRadius + 50.f;
+			break;
+		case EAIPerceptionProfile::Combat:
+			SightConfig.SightRadius = 1400.f;
+			SightConfig.LoseSightRadius = SightConfig.SightRadius + 100.f;
+			break;
+		default:
 			break;
+	}
+}
+
+// Switch to the perception profile for the current state
+void ABaseAIController::UpdatePerceptionProfile()
+{
+	EAIPerceptionProfile NewProfile = EAIPerceptionProfile::Patrol;
+	switch (CurrentState)
+	{
 		case EAIState::Chase:
 		case EAIState::Combat:
-			SightConfig->SightRadius = 1400.f;
-			SightConfig->LoseSightRadius = SightConfig->SightRadius + 100.f;
+			NewProfile = EAIPerceptionProfile::Combat;
+			break;
+		case EAIState::Stunned:
+			// Keep whatever was being used before the stun
+			NewProfile = PerceptionProfile != EAIPerceptionProfile::NUM_PROFILES ? PerceptionProfile : NewProfile;
 			break;
 		default:
 			break;
 	}
 
-	// Need to reconfigure to let the sense know values have been changed
+	// Already using it, nothing to reconfigure
+	if (NewProfile == PerceptionProfile)
+	{
+		return;
+	}
+
+	UAIPerceptionComponent* Perception = GetPerceptionComponent();
+	ASSERT_RETURN(Perception != nullptr);
+
+	UAIPerceptionProfileSubsystem* ProfileSubsystem = GetWorld()->GetSubsystem<UAIPerceptionProfileSubsystem>();
+	ASSERT_RETURN(ProfileSubsystem != nullptr);
+
+	UAISenseConfig_Sight* SightConfig = ProfileSubsystem->GetSightConfig(*this, NewProfile);
+	ASSERT_RETURN(SightConfig != nullptr);
+
+	PerceptionProfile = NewProfile;
+
+	// Swapping the config replaces the previous sight config on the component
 	Perception->ConfigureSense(*SightConfig);
 
 	// Update BB
@@ -8,6 +8,7 @@
 #include "BehaviorTree/BehaviorTreeTypes.h"
 #include "BehaviorTree/BlackboardAssetProvider.h"
 
+#include "RC/AI/AIDecisionSubsystem.h"
 #include "RC/Util/RCTypes.h"
 
 #include "BaseAIController.generated.h"
@@ -134,6 +135,9 @@ public:
 	 */
 	EAIStateChangeResult RequestState(EAIState NewState);	
 
+	// Get the current AI state
+	EAIState GetCurrentState() const { return CurrentState; }
+
 	// Stun the AI, preventing further action and being placed in Stunned AI State
 	UFUNCTION(BlueprintCallable)
 	void StunAI();
@@ -142,6 +146,36 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void UnstunAI();
 
+	// Put the AI back into its default state, forgetting anything it's perceived and clearing the blackboard
+	void ResetAI();
+
+	/**
+	 * Set whether the AI is running its logic and reacting to perception
+	 * @param bActive	Whether the AI should be active
+	 */
+	void SetAIActive(bool bActive);
+
+	// Whether the AI is running its logic
+	bool IsAIActive() const { return bAIActive; }
+
+	/**
+	 * Fill out the inputs for the AI decision pass
+	 * @param Snapshot	The snapshot to fill
+	 */
+	void FillDecisionSnapshot(struct FAIDecisionSnapshot& Snapshot) const;
+
+	// Whether the decision pass can change this AI's state
+	bool CanMakeDecisions() const;
+
+	/**
+	 * Fill out the sight config for a perception profile.
+	 * Called once on the class defaults, the config is then shared by every controller of the class
+	 *
+	 * @param Profile		The profile being created
+	 * @param SightConfig	The config to fill out
+	 */
+	virtual void SetupSightProfile(EAIPerceptionProfile Profile, class UAISenseConfig_Sight& SightConfig) const;
+
 	// Message to send out for nodes waiting on state chagnes
 	static const FName AIMessage_StateChangeFinished;
 
@@ -149,6 +183,12 @@ protected:
 	// Called when the game starts or when spawned
 	void BeginPlay() override;
 
+	// Called when the controller is being removed
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Start the AI's logic running again when it's activated, which is the behavior tree unless a subclass drives the AI itself
+	virtual void StartLogic();
+
 	// BEGIN IBlackboardAssetProvider
 	/// Get the blackboard asset
 	virtual UBlackboardData* GetBlackboardAsset() const override;
@@ -183,8 +223,8 @@ private:
 	// Setup perception configs
 	void SetupPerception();
 
-	// Update the perception sight configs
-	void UpdatePerceptionSight();
+	// Switch to the perception profile for the current state
+	void UpdatePerceptionProfile();
 
 	// State to start in
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = AI, meta = (AllowPrivateAccess = "true"))
@@ -211,9 +251,11 @@ private:
 	struct FBlackboardKeySelector RequestedStateKey;
 
 	// Sense configs
-	class UAISenseConfig_Sight* SightConfig = nullptr;
 	class UAISenseConfig_Damage* DamageConfig = nullptr;
 
+	// The perception profile in use
+	EAIPerceptionProfile PerceptionProfile = EAIPerceptionProfile::NUM_PROFILES;
+
 	// Current AI state
 	EAIState CurrentState = EAIState::NUM_STATES;
 
@@ -226,6 +268,26 @@ private:
 	// Whether the AI is currently stunned and shouldn't change state
 	bool bStunned = false;
 
+	// Whether the AI is running, inactive AI ignore perception
+	bool bAIActive = true;
+
+	// Whether the AI decision pass chooses this AI's state
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Utility", meta = (AllowPrivateAccess = "true"))
+	bool bUseUtilityDecisions = false;
+
+	// Tuning for the AI decision pass
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Utility", meta = (AllowPrivateAccess = "true", EditCondition = "bUseUtilityDecisions", EditConditionHides))
+	FAIUtilitySettings UtilitySettings;
+
+	// Whether the player is currently seen
+	bool bCanSeePlayer = false;
+
+	// World time the player was last seen, negative if never
+	float LastSeenPlayerTime = -1.0f;
+
+	// World time the AI was last damaged, negative if never
+	float LastDamagedTime = -1.0f;
+
 	// All the state transition predicates
 	TStateTransitionMap StateTransitions;
 };
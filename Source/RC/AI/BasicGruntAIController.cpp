@@ -3,6 +3,261 @@
 
 #include "BasicGruntAIController.h"
 
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Perception/AIPerceptionComponent.h"
+
+#include "RC/AI/BlackBoardKeys.h"
+#include "RC/AI/ChaseFlowFieldSubsystem.h"
+#include "RC/AI/SplineFollowerComponent.h"
+#include "RC/Characters/Enemies/BaseEnemy.h"
+#include "RC/Debug/Debug.h"
+
+ABasicGruntAIController::ABasicGruntAIController(const FObjectInitializer& ObjectInitializer/* = FObjectInitializer::Get()*/)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+// Called when the game starts or when spawned
+void ABasicGruntAIController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bUseNativeBrain)
+	{
+		SetNativeBrainActive(ShouldUseNativeBrain());
+	}
+}
+
+// Called every frame
+void ABasicGruntAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bUseNativeBrain || !IsAIActive())
+	{
+		return;
+	}
+
+	ABaseEnemy* Enemy = GetPawn<ABaseEnemy>();
+	if (Enemy == nullptr || Enemy->IsDead())
+	{
+		return;
+	}
+
+	// Decisions only need to be made every so often
+	if (!NextThinkTimer.IsActive())
+	{
+		NextThinkTimer.Set(ThinkInterval);
+
+		// Hand off between the native brain and the behavior tree, making sure the tree didn't get restarted under us
+		const bool bNative = ShouldUseNativeBrain();
+		UBrainComponent* Brain = GetBrainComponent();
+		if (bNative != bNativeBrainActive || (bNative && Brain != nullptr && Brain->IsRunning()))
+		{
+			SetNativeBrainActive(bNative);
+		}
+
+		if (bNativeBrainActive)
+		{
+			Think();
+		}
+	}
+
+	// Steering needs input every frame
+	if (bNativeBrainActive && NativeBrainState == EAIState::Chase)
+	{
+		ThinkChase();
+	}
+}
+
+// Continue the native brain's patrol once a move has finished
+void ABasicGruntAIController::OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result)
+{
+	Super::OnMoveCompleted(RequestID, Result);
+
+	if (!bNativeBrainActive || NativeBrainState != EAIState::Patrol || !Result.IsSuccess())
+	{
+		return;
+	}
+
+	ABaseEnemy* Enemy = GetPawn<ABaseEnemy>();
+	if (Enemy != nullptr && Enemy->GetSplineFollower() != nullptr)
+	{
+		Enemy->GetSplineFollower()->AdvanceToNextPatrolPoint();
+		ThinkPatrol();
+	}
+}
+
+// Decide between the native brain and the behavior tree before either starts running
+void ABasicGruntAIController::StartLogic()
+{
+	if (!bUseNativeBrain)
+	{
+		Super::StartLogic();
+		return;
+	}
+
+	// Think on the first tick rather than waiting out the last interval from before the AI was deactivated
+	NextThinkTimer.Invalidate();
+	SetNativeBrainActive(ShouldUseNativeBrain());
+}
+
+// Whether the native brain should be running for the current state and distance to the player
+bool ABasicGruntAIController::ShouldUseNativeBrain() const
+{
+	switch (GetCurrentState())
+	{
+		case EAIState::Idle:
+		case EAIState::Patrol:
+		case EAIState::Search:
+		case EAIState::Chase:
+			break;
+		default:
+			// Everything else is left to the behavior tree
+			return false;
+	}
+
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (Player == nullptr || GetPawn() == nullptr)
+	{
+		return true;
+	}
+
+	// Don't flip back and forth right at the edge
+	const float Distance = BehaviorTreeDistance + (bNativeBrainActive ? 0.0f : NativeBrainHysteresis);
+	return FVector::DistSquared(Player->GetActorLocation(), GetPawn()->GetActorLocation()) > FMath::Square(Distance);
+}
+
+// Switch between the native brain and the behavior tree
+void ABasicGruntAIController::SetNativeBrainActive(bool bNative)
+{
+	UBrainComponent* Brain = GetBrainComponent();
+	ASSERT_RETURN(Brain != nullptr);
+
+	// The blackboard is left alone so the tree picks up right where the native brain left off
+	if (bNative)
+	{
+		Brain->StopLogic(TEXT("Native Brain"));
+	}
+	else
+	{
+		StopMovement();
+		Brain->RestartLogic();
+	}
+
+	bNativeBrainActive = bNative;
+	NativeBrainState = EAIState::NUM_STATES;
+}
+
+// Run a single update of the native brain
+void ABasicGruntAIController::Think()
+{
+	const EAIState State = GetCurrentState();
+	const bool bEnteredState = State != NativeBrainState;
+	NativeBrainState = State;
+
+	switch (State)
+	{
+		case EAIState::Idle:
+			if (bEnteredState)
+			{
+				StopMovement();
+			}
+			break;
+		case EAIState::Patrol:
+			if (bEnteredState || GetMoveStatus() == EPathFollowingStatus::Idle)
+			{
+				ThinkPatrol();
+			}
+			break;
+		case EAIState::Search:
+			if (bEnteredState)
+			{
+				SearchTimer.Set(SearchDuration);
+				ThinkSearch();
+			}
+			else if (SearchTimer.Elapsed())
+			{
+				SearchTimer.Invalidate();
+				RequestState(EAIState::Patrol);
+			}
+			break;
+		case EAIState::Chase:
+			if (bEnteredState)
+			{
+				StopMovement();
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+// Native brain for patrolling
+void ABasicGruntAIController::ThinkPatrol()
+{
+	ABaseEnemy* Enemy = GetPawn<ABaseEnemy>();
+	ASSERT_RETURN(Enemy != nullptr);
+
+	USplineFollowerComponent* SplineFollower = Enemy->GetSplineFollower();
+	LOG_RETURN(SplineFollower != nullptr, LogAISpline, Warning, "No spline follower for actor %s", *Enemy->GetName());
+
+	MoveToLocation(SplineFollower->GetCurrentPatrolPosition(), PatrolAcceptanceRadius);
+}
+
+// Native brain for searching
+void ABasicGruntAIController::ThinkSearch()
+{
+	UBlackboardComponent* BlackBoardComponent = GetBlackBoard();
+	ASSERT_RETURN(BlackBoardComponent != nullptr);
+
+	AActor* LastTarget = Cast<AActor>(BlackBoardComponent->GetValueAsObject(BlackBoardKeys::LAST_DETECTED_TARGET_ACTOR));
+	if (LastTarget == nullptr)
+	{
+		return;
+	}
+
+	// Head to where they were last perceived
+	FVector SearchLocation = LastTarget->GetActorLocation();
+	UAIPerceptionComponent* Perception = GetPerceptionComponent();
+	const FActorPerceptionInfo* PerceptionInfo = Perception != nullptr ? Perception->GetActorInfo(*LastTarget) : nullptr;
+	if (PerceptionInfo != nullptr)
+	{
+		SearchLocation = PerceptionInfo->GetLastStimulusLocation();
+	}
+
+	MoveToLocation(SearchLocation);
+}
+
+// Native brain for chasing
+void ABasicGruntAIController::ThinkChase()
+{
+	APawn* Enemy = GetPawn();
+	ASSERT_RETURN(Enemy != nullptr);
+
+	// Steer with the shared flow field
+	UChaseFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UChaseFlowFieldSubsystem>();
+	FVector Direction;
+	if (FlowField != nullptr && FlowField->GetChaseDirection(GetNavAgentPropertiesRef(), Enemy->GetNavAgentLocation(), Direction))
+	{
+		if (GetMoveStatus() != EPathFollowingStatus::Idle)
+		{
+			StopMovement();
+		}
+		Enemy->AddMovementInput(Direction);
+		return;
+	}
+
+	// Outside the field, fall back to pathing
+	if (GetMoveStatus() == EPathFollowingStatus::Idle)
+	{
+		MoveToActor(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	}
+}
+
 /*
 void ABasicGruntAIController::SetupStateTransitions()
 {
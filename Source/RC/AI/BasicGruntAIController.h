@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "RC/AI/BaseAIController.h"
+#include "RC/Util/TimeStamp.h"
 #include "BasicGruntAIController.generated.h"
 
 /**
- * 
+ * Grunt AI that can run a lightweight native brain for Idle, Patrol, Search and Chase while far from the player.
+ * Hands off to the behavior tree once in combat or close to the player, sharing the same blackboard
  */
 UCLASS()
 class RC_API ABasicGruntAIController : public ABaseAIController
@@ -15,7 +17,81 @@ class RC_API ABasicGruntAIController : public ABaseAIController
 	GENERATED_BODY()
 
 public:
+	ABasicGruntAIController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// Called every frame
+	void Tick(float DeltaTime) override;
+
+	// Whether the native brain is running instead of the behavior tree
+	bool IsNativeBrainActive() const { return bNativeBrainActive; }
 
 protected:
+	// Called when the game starts or when spawned
+	void BeginPlay() override;
+
+	// Continue the native brain's patrol once a move has finished
+	void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+	// Decide between the native brain and the behavior tree before either starts running
+	void StartLogic() override;
+
 	//virtual void SetupStateTransitions() override;
+
+private:
+	// Whether the native brain should be running for the current state and distance to the player
+	bool ShouldUseNativeBrain() const;
+
+	/**
+	 * Switch between the native brain and the behavior tree
+	 * @param bNative	Whether the native brain should run
+	 */
+	void SetNativeBrainActive(bool bNative);
+
+	// Run a single update of the native brain
+	void Think();
+
+	// Native brain for patrolling
+	void ThinkPatrol();
+
+	// Native brain for searching
+	void ThinkSearch();
+
+	// Native brain for chasing
+	void ThinkChase();
+
+	// Whether to run the native brain while the enemy is far away
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Native Brain", meta = (AllowPrivateAccess = "true"))
+	bool bUseNativeBrain = false;
+
+	// Distance to the player within which the behavior tree takes over
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Native Brain", meta = (AllowPrivateAccess = "true", EditCondition = "bUseNativeBrain", EditConditionHides))
+	float BehaviorTreeDistance = 2000.0f;
+
+	// Extra distance past the behavior tree distance before the native brain takes back over
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Native Brain", meta = (AllowPrivateAccess = "true", EditCondition = "bUseNativeBrain", EditConditionHides))
+	float NativeBrainHysteresis = 300.0f;
+
+	// Time between native brain updates
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Native Brain", meta = (AllowPrivateAccess = "true", EditCondition = "bUseNativeBrain", EditConditionHides))
+	float ThinkInterval = 0.25f;
+
+	// How close to a patrol point counts as reaching it
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Native Brain", meta = (AllowPrivateAccess = "true", EditCondition = "bUseNativeBrain", EditConditionHides))
+	float PatrolAcceptanceRadius = 50.0f;
+
+	// How long to search the last known location before going back to patrolling
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI|Native Brain", meta = (AllowPrivateAccess = "true", EditCondition = "bUseNativeBrain", EditConditionHides))
+	float SearchDuration = 5.0f;
+
+	// Whether the native brain is running instead of the behavior tree
+	bool bNativeBrainActive = false;
+
+	// The state the native brain last acted on
+	EAIState NativeBrainState = EAIState::NUM_STATES;
+
+	// Time until the next native brain update
+	FTimeStamp NextThinkTimer;
+
+	// Time until searching gives up
+	FTimeStamp SearchTimer;
 };
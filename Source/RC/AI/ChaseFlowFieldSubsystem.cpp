@@ -0,0 +1,331 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "ChaseFlowFieldSubsystem.h"
+
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+
+#include "RC/AI/PlayerNavigationSubsystem.h"
+#include "RC/Debug/Debug.h"
+
+const float UChaseFlowFieldSubsystem::CellSize = 100.0f;
+const float UChaseFlowFieldSubsystem::CellHeight = 120.0f;
+const int32 UChaseFlowFieldSubsystem::FieldHalfExtent = 40;
+const int32 UChaseFlowFieldSubsystem::FieldHalfHeight = 4;
+const float UChaseFlowFieldSubsystem::MaxStepHeight = 60.0f;
+const float UChaseFlowFieldSubsystem::RebuildDistance = 300.0f;
+const int32 UChaseFlowFieldSubsystem::MaxCachedCells = 65536;
+const int32 UChaseFlowFieldSubsystem::MaxProjectionsPerFrame = 512;
+
+namespace
+{
+	// Cost of moving to an orthogonal neighbour
+	const int32 StraightCost = 10;
+
+	// Cost of moving to a diagonal neighbour
+	const int32 DiagonalCost = 14;
+
+	// Order the open list by cost
+	const auto CheaperCell = [](const TPair<int32, FIntVector>& A, const TPair<int32, FIntVector>& B) { return A.Key < B.Key; };
+
+	// Offsets to each neighbour of a cell, orthogonal first
+	const FIntPoint NeighbourOffsets[] =
+	{
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+
+	// Height bands a neighbour is looked for in, the same band first so slopes crossing a band are still connected
+	const int32 NeighbourBands[] = { 0, 1, -1 };
+}
+
+// Continue building the fields that are out of date
+void UChaseFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	int32 Projections = MaxProjectionsPerFrame;
+	for (auto Iter = Fields.CreateIterator(); Iter; ++Iter)
+	{
+		const ANavigationData* NavData = Iter.Key().Get();
+		if (NavData == nullptr)
+		{
+			Iter.RemoveCurrent();
+			continue;
+		}
+
+		FFlowField& FlowField = Iter.Value();
+		if (FlowField.bBuilding && Projections > 0)
+		{
+			BuildField(FlowField, *NavData, Projections);
+		}
+	}
+}
+
+// Get the direction to steer in to reach the player
+bool UChaseFlowFieldSubsystem::GetChaseDirection(const FNavAgentProperties& AgentProps, const FVector& Location, FVector& OutDirection)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	ASSERT_RETURN_VALUE(NavSys != nullptr, false);
+
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProps);
+	ASSERT_RETURN_VALUE(NavData != nullptr, false);
+
+	FFlowField& FlowField = Fields.FindOrAdd(NavData);
+	FlowField.AgentProps = AgentProps;
+	UpdateGoal(FlowField);
+
+	// The location can sit just across a band from the navmesh under it, so check the bands either side too
+	const FCostMap& Field = FlowField.Field;
+	FIntVector Cell = GetCell(Location);
+	const int32 Index = FindReachableCell(Field, Cell);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Already in the goal cell, head straight for the player
+	if (Field.Costs[Index] == 0)
+	{
+		OutDirection = (Field.GoalLocation - Location).GetSafeNormal2D();
+		return true;
+	}
+
+	// Head towards the cheapest neighbour
+	FIntVector BestCell = Cell;
+	int32 BestCost = Field.Costs[Index];
+	for (const FIntPoint& Offset : NeighbourOffsets)
+	{
+		for (const int32 Band : NeighbourBands)
+		{
+			const FIntVector Neighbour(Cell.X + Offset.X, Cell.Y + Offset.Y, Cell.Z + Band);
+			const int32 NeighbourIndex = GetFieldIndex(Field, Neighbour);
+			if (NeighbourIndex != INDEX_NONE && Field.Costs[NeighbourIndex] < BestCost)
+			{
+				BestCost = Field.Costs[NeighbourIndex];
+				BestCell = Neighbour;
+			}
+		}
+	}
+	if (BestCell == Cell)
+	{
+		return false;
+	}
+
+	const FVector Target((BestCell.X + 0.5f) * CellSize, (BestCell.Y + 0.5f) * CellSize, Location.Z);
+	OutDirection = (Target - Location).GetSafeNormal2D();
+	return true;
+}
+
+// Start building a new field if the player has moved far enough from where the field was built for
+void UChaseFlowFieldSubsystem::UpdateGoal(FFlowField& FlowField)
+{
+	// Only need to check once a frame
+	if (FlowField.LastUpdateFrame == GFrameCounter)
+	{
+		return;
+	}
+	FlowField.LastUpdateFrame = GFrameCounter;
+
+	UPlayerNavigationSubsystem* PlayerNavigation = GetWorld()->GetSubsystem<UPlayerNavigationSubsystem>();
+	ASSERT_RETURN(PlayerNavigation != nullptr);
+
+	// Leave the previous field if the player is off the navmesh, they'll be chased to where they left it
+	FNavLocation PlayerLocation;
+	if (!PlayerNavigation->GetPlayerNavLocation(FlowField.AgentProps, PlayerLocation))
+	{
+		return;
+	}
+
+	// Chasers that reach the goal cell head straight for the player, wherever they are near it
+	FlowField.Field.GoalLocation = PlayerLocation.Location;
+
+	// Let the field being built finish first, the player's new location is picked up once it has
+	if (FlowField.bBuilding)
+	{
+		FlowField.PendingField.GoalLocation = PlayerLocation.Location;
+		return;
+	}
+
+	// Keep the field while the player stays close to where it was built and somewhere it reaches, such as the same floor
+	const FIntVector NewGoalCell = GetCell(PlayerLocation.Location);
+	const int32 NewGoalIndex = GetFieldIndex(FlowField.Field, NewGoalCell);
+	if (NewGoalIndex != INDEX_NONE && FlowField.Field.Costs[NewGoalIndex] != MAX_int32
+		&& FVector::DistSquared(PlayerLocation.Location, FlowField.Field.BuildLocation) <= FMath::Square(RebuildDistance))
+	{
+		return;
+	}
+
+	if (FlowField.CellInfos.Num() > MaxCachedCells)
+	{
+		FlowField.CellInfos.Reset();
+	}
+
+	FCostMap& PendingField = FlowField.PendingField;
+	PendingField.GoalCell = NewGoalCell;
+	PendingField.GoalLocation = PlayerLocation.Location;
+	PendingField.BuildLocation = PlayerLocation.Location;
+
+	// The player's cell is known to be walkable from the projection
+	FCellInfo& GoalInfo = FlowField.CellInfos.FindOrAdd(NewGoalCell);
+	GoalInfo.bWalkable = true;
+	GoalInfo.Height = PlayerLocation.Location.Z;
+
+	const int32 FieldSize = FieldHalfExtent * 2 + 1;
+	const int32 FieldLayers = FieldHalfHeight * 2 + 1;
+	PendingField.Costs.Init(MAX_int32, FieldSize * FieldSize * FieldLayers);
+	PendingField.Costs[GetFieldIndex(PendingField, NewGoalCell)] = 0;
+
+	// Dijkstra out from the player, over as many frames as it takes
+	FlowField.Open.Reset();
+	FlowField.Open.HeapPush(TPair<int32, FIntVector>(0, NewGoalCell), CheaperCell);
+	FlowField.bBuilding = true;
+}
+
+// Continue building a field
+void UChaseFlowFieldSubsystem::BuildField(FFlowField& FlowField, const ANavigationData& NavData, int32& Projections)
+{
+	FCostMap& PendingField = FlowField.PendingField;
+	while (FlowField.Open.Num() != 0)
+	{
+		// Out of projections, carry on next frame
+		if (Projections <= 0)
+		{
+			return;
+		}
+
+		TPair<int32, FIntVector> Current;
+		FlowField.Open.HeapPop(Current, CheaperCell);
+
+		// Stale entry that's already been reached for cheaper
+		if (Current.Key > PendingField.Costs[GetFieldIndex(PendingField, Current.Value)])
+		{
+			continue;
+		}
+
+		for (int32 NeighbourIndex = 0; NeighbourIndex < UE_ARRAY_COUNT(NeighbourOffsets); ++NeighbourIndex)
+		{
+			FIntVector Neighbour;
+			if (!FindNeighbour(FlowField, Current.Value, NeighbourOffsets[NeighbourIndex], NavData, Projections, Neighbour))
+			{
+				continue;
+			}
+
+			const int32 FieldIndex = GetFieldIndex(PendingField, Neighbour);
+			const int32 Cost = Current.Key + (NeighbourIndex < 4 ? StraightCost : DiagonalCost);
+			if (FieldIndex == INDEX_NONE || Cost >= PendingField.Costs[FieldIndex])
+			{
+				continue;
+			}
+
+			PendingField.Costs[FieldIndex] = Cost;
+			FlowField.Open.HeapPush(TPair<int32, FIntVector>(Cost, Neighbour), CheaperCell);
+		}
+	}
+
+	// Finished, chasers can start steering with it
+	Swap(FlowField.Field, FlowField.PendingField);
+	FlowField.bBuilding = false;
+}
+
+// Get the navmesh info of the cell, projecting it if it hasn't been yet
+const UChaseFlowFieldSubsystem::FCellInfo& UChaseFlowFieldSubsystem::GetCellInfo(FFlowField& FlowField, const FIntVector& Cell, const ANavigationData& NavData, int32& Projections)
+{
+	FCellInfo* CachedInfo = FlowField.CellInfos.Find(Cell);
+	if (CachedInfo != nullptr)
+	{
+		return *CachedInfo;
+	}
+
+	// Only look for the navmesh inside the cell's own band so floors above and below aren't found
+	FCellInfo& Info = FlowField.CellInfos.Add(Cell);
+	const FVector CellCenter((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, (Cell.Z + 0.5f) * CellHeight);
+	const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, CellHeight * 0.5f);
+
+	FNavLocation Projected;
+	Info.bWalkable = NavData.ProjectPoint(CellCenter, Projected, Extent) && GetCell(Projected.Location).Z == Cell.Z;
+	Info.Height = Info.bWalkable ? Projected.Location.Z : CellCenter.Z;
+	--Projections;
+	return Info;
+}
+
+// Find the cell next to a cell that you can move to
+bool UChaseFlowFieldSubsystem::FindNeighbour(FFlowField& FlowField, const FIntVector& From, const FIntPoint& Offset, const ANavigationData& NavData, int32& Projections, FIntVector& OutNeighbour)
+{
+	const float FromHeight = GetCellInfo(FlowField, From, NavData, Projections).Height;
+	for (const int32 Band : NeighbourBands)
+	{
+		const FIntVector To(From.X + Offset.X, From.Y + Offset.Y, From.Z + Band);
+		const FCellInfo& ToInfo = GetCellInfo(FlowField, To, NavData, Projections);
+		if (!ToInfo.bWalkable || FMath::Abs(ToInfo.Height - FromHeight) > MaxStepHeight)
+		{
+			continue;
+		}
+
+		// Don't cut diagonally across corners
+		if (Offset.X != 0 && Offset.Y != 0)
+		{
+			if (!IsWalkableNear(FlowField, FIntVector(To.X, From.Y, From.Z), NavData, Projections) || !IsWalkableNear(FlowField, FIntVector(From.X, To.Y, From.Z), NavData, Projections))
+			{
+				return false;
+			}
+		}
+
+		OutNeighbour = To;
+		return true;
+	}
+	return false;
+}
+
+// Get whether the cell or the bands either side of it are on the navmesh
+bool UChaseFlowFieldSubsystem::IsWalkableNear(FFlowField& FlowField, const FIntVector& Cell, const ANavigationData& NavData, int32& Projections)
+{
+	for (const int32 Band : NeighbourBands)
+	{
+		if (GetCellInfo(FlowField, FIntVector(Cell.X, Cell.Y, Cell.Z + Band), NavData, Projections).bWalkable)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Get the cell containing a world location
+FIntVector UChaseFlowFieldSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellHeight));
+}
+
+// Get the index of a cell in a cost map, or INDEX_NONE if it's outside
+int32 UChaseFlowFieldSubsystem::GetFieldIndex(const FCostMap& CostMap, const FIntVector& Cell) const
+{
+	// No field built yet
+	if (CostMap.Costs.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 X = Cell.X - CostMap.GoalCell.X + FieldHalfExtent;
+	const int32 Y = Cell.Y - CostMap.GoalCell.Y + FieldHalfExtent;
+	const int32 Z = Cell.Z - CostMap.GoalCell.Z + FieldHalfHeight;
+	const int32 FieldSize = FieldHalfExtent * 2 + 1;
+	const int32 FieldLayers = FieldHalfHeight * 2 + 1;
+	if (X < 0 || Y < 0 || Z < 0 || X >= FieldSize || Y >= FieldSize || Z >= FieldLayers)
+	{
+		return INDEX_NONE;
+	}
+	return (Z * FieldSize + Y) * FieldSize + X;
+}
+
+// Find the band of a cell that can reach the goal, checking the bands either side of it
+int32 UChaseFlowFieldSubsystem::FindReachableCell(const FCostMap& CostMap, FIntVector& InOutCell) const
+{
+	for (const int32 Band : NeighbourBands)
+	{
+		const FIntVector Cell(InOutCell.X, InOutCell.Y, InOutCell.Z + Band);
+		const int32 Index = GetFieldIndex(CostMap, Cell);
+		if (Index != INDEX_NONE && CostMap.Costs[Index] != MAX_int32)
+		{
+			InOutCell = Cell;
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ChaseFlowFieldSubsystem.generated.h"
+
+/**
+ * Dijkstra maps centred on the player's navmesh location that chasing AI can sample for steering,
+ * so every chaser shares one field update instead of each running its own path query.
+ * Cells are banded by height so floors stacked above each other stay apart.
+ * There's a field for each nav data, rebuilt over several frames when the player moves far enough from where it was built or somewhere it doesn't reach.
+ * Chasers keep using the previous field until the new one is finished
+ */
+UCLASS()
+class RC_API UChaseFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// FTickableGameObject implementation Begin
+	// Whether this subsystem should tick
+	virtual bool IsTickable() const override { return Fields.Num() != 0 && Super::IsTickable(); }
+
+	// Continue building the fields that are out of date
+	virtual void Tick(float DeltaTime) override;
+
+	// Needed for tickables
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UChaseFlowFieldSubsystem, STATGROUP_Tickables); }
+	// FTickableGameObject implementation End
+
+	/**
+	 * Get the direction to steer in to reach the player
+	 *
+	 * @param AgentProps	The properties of the agent that is chasing
+	 * @param Location		The location of the agent
+	 * @param OutDirection	The normalized direction to move in
+	 * Returns false if the location isn't inside the field, can't reach the player or the field hasn't been built yet
+	 */
+	bool GetChaseDirection(const FNavAgentProperties& AgentProps, const FVector& Location, FVector& OutDirection);
+
+private:
+	/**
+	 * Navmesh info for a single cell
+	 */
+	struct FCellInfo
+	{
+		// Whether the cell is on the navmesh
+		bool bWalkable = false;
+
+		// Height of the navmesh in the cell
+		float Height = 0;
+	};
+
+	/**
+	 * The costs to reach a goal cell from each cell around it
+	 */
+	struct FCostMap
+	{
+		// Cost to reach the goal from each cell in the map
+		TArray<int32> Costs;
+
+		// The cell the player was in when the map was built
+		FIntVector GoalCell = FIntVector(MAX_int32, MAX_int32, MAX_int32);
+
+		// The player's latest location on the navmesh
+		FVector GoalLocation = FVector::ZeroVector;
+
+		// The player's location on the navmesh when the map was built
+		FVector BuildLocation = FVector::ZeroVector;
+	};
+
+	/**
+	 * The field for a single nav data
+	 */
+	struct FFlowField
+	{
+		// The properties of the agents using this field, to find the player on its navmesh
+		FNavAgentProperties AgentProps;
+
+		// Navmesh info of every cell that's been projected, kept between rebuilds so only new cells need projecting
+		TMap<FIntVector, FCellInfo> CellInfos;
+
+		// The finished field that chasers steer with
+		FCostMap Field;
+
+		// The field being built
+		FCostMap PendingField;
+
+		// Cells still to be expanded in the field being built, ordered by cost
+		TArray<TPair<int32, FIntVector>> Open;
+
+		// Whether a field is being built
+		bool bBuilding = false;
+
+		// Frame the player was last checked for moving away from the goal
+		uint64 LastUpdateFrame = 0;
+	};
+
+	/**
+	 * Start building a new field if the player has moved far enough from where the field was built for
+	 * @param FlowField	The field to update
+	 */
+	void UpdateGoal(FFlowField& FlowField);
+
+	/**
+	 * Continue building a field
+	 * @param FlowField		The field to build
+	 * @param NavData		The nav data of the field
+	 * @param Projections	Number of cells that can still be projected this frame, reduced by the ones projected
+	 */
+	void BuildField(FFlowField& FlowField, const class ANavigationData& NavData, int32& Projections);
+
+	// Get the navmesh info of the cell, projecting it if it hasn't been yet
+	const FCellInfo& GetCellInfo(FFlowField& FlowField, const FIntVector& Cell, const class ANavigationData& NavData, int32& Projections);
+
+	/**
+	 * Find the cell next to a cell that you can move to
+	 * @param FlowField		The field the cells are in
+	 * @param From			The cell to move from
+	 * @param Offset		The direction of the neighbour
+	 * @param NavData		The nav data of the field
+	 * @param Projections	Number of cells that can still be projected this frame, reduced by the ones projected
+	 * @param OutNeighbour	The neighbour, in the same band or the ones either side of it
+	 * Returns false if there's no neighbour you can move to in that direction
+	 */
+	bool FindNeighbour(FFlowField& FlowField, const FIntVector& From, const FIntPoint& Offset, const class ANavigationData& NavData, int32& Projections, FIntVector& OutNeighbour);
+
+	// Get whether the cell or the bands either side of it are on the navmesh
+	bool IsWalkableNear(FFlowField& FlowField, const FIntVector& Cell, const class ANavigationData& NavData, int32& Projections);
+
+	// Get the cell containing a world location
+	FIntVector GetCell(const FVector& Location) const;
+
+	// Get the index of a cell in a cost map, or INDEX_NONE if it's outside
+	int32 GetFieldIndex(const FCostMap& CostMap, const FIntVector& Cell) const;
+
+	/**
+	 * Find the band of a cell that can reach the goal, checking the bands either side of it
+	 * @param CostMap	The cost map to look in
+	 * @param InOutCell	The cell to look from, set to the one found
+	 * Returns the index of the cell found, or INDEX_NONE if none of them can reach the goal
+	 */
+	int32 FindReachableCell(const FCostMap& CostMap, FIntVector& InOutCell) const;
+
+	// The field of each nav data
+	TMap<TWeakObjectPtr<const class ANavigationData>, FFlowField> Fields;
+
+	// Size of each cell
+	static const float CellSize;
+
+	// Height of each cell's band
+	static const float CellHeight;
+
+	// Number of cells from the goal to the edge of the field
+	static const int32 FieldHalfExtent;
+
+	// Number of bands from the goal to the top and bottom of the field
+	static const int32 FieldHalfHeight;
+
+	// Max height difference between neighbouring cells to be connected
+	static const float MaxStepHeight;
+
+	// How far the player can move from where the field was built before it's rebuilt
+	static const float RebuildDistance;
+
+	// Max number of cell infos to keep before they're thrown out
+	static const int32 MaxCachedCells;
+
+	// Max number of cells projected onto the navmesh each frame across every field
+	static const int32 MaxProjectionsPerFrame;
+};
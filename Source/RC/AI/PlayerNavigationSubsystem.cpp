@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "PlayerNavigationSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+
+#include "RC/Debug/Debug.h"
+
+// Get the player's location projected onto the navmesh used by the agent
+bool UPlayerNavigationSubsystem::GetPlayerNavLocation(const FNavAgentProperties& AgentProps, FNavLocation& OutLocation)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	ASSERT_RETURN_VALUE(NavSys != nullptr, false);
+
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProps);
+	LOG_RETURN_VALUE(NavData != nullptr, false, LogAI, Warning, "No nav data for agent radius %f", AgentProps.AgentRadius);
+
+	// Already projected this frame
+	FCachedProjection& Projection = CachedProjections.FindOrAdd(NavData);
+	if (Projection.Frame == GFrameCounter)
+	{
+		OutLocation = Projection.Location;
+		return Projection.bSucceeded;
+	}
+
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	ASSERT_RETURN_VALUE(Player != nullptr, false);
+
+	Projection.Frame = GFrameCounter;
+	Projection.bSucceeded = NavSys->ProjectPointToNavigation(Player->GetActorLocation(), Projection.Location, INVALID_NAVEXTENT, NavData);
+
+	OutLocation = Projection.Location;
+	return Projection.bSucceeded;
+}
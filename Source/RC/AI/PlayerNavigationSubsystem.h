@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "PlayerNavigationSubsystem.generated.h"
+
+/**
+ * Shares the player's projection onto the navmesh between every AI.
+ * The projection is done lazily at most once per frame for each nav agent type
+ */
+UCLASS()
+class RC_API UPlayerNavigationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Get the player's location projected onto the navmesh used by the agent
+	 *
+	 * @param AgentProps	The properties of the agent that will navigate to the location
+	 * @param OutLocation	The projected location
+	 * Returns true if the player could be projected onto the navmesh
+	 */
+	bool GetPlayerNavLocation(const FNavAgentProperties& AgentProps, FNavLocation& OutLocation);
+
+private:
+	/**
+	 * A projection of the player for a single nav data
+	 */
+	struct FCachedProjection
+	{
+		// Frame the projection was made on
+		uint64 Frame = 0;
+
+		// Whether the projection found the navmesh
+		bool bSucceeded = false;
+
+		// The projected location
+		FNavLocation Location;
+	};
+
+	// Projections of this frame keyed by the nav data of each agent type
+	TMap<TWeakObjectPtr<const class ANavigationData>, FCachedProjection> CachedProjections;
+};
@@ -4,6 +4,7 @@
 
 #include "Components/SplineComponent.h"
 
+#include "RC/AI/SplineLookupTable.h"
 #include "RC/Debug/Debug.h"
 
 // Sets default values for this component's properties
@@ -30,24 +31,36 @@ void USplineFollowerComponent::BeginPlay()
 	// Set the current position to the start
 	if (SplineComponent != nullptr)
 	{
+		SplineLookupTable = FSplineLookupTable::FindOrCreate(*SplineComponent);
 		CurrentTargetPosition = SplineComponent->GetLocationAtSplinePoint(CurrentTargetPoint, ESplineCoordinateSpace::World);
 	}
 }
 
+// Release the spline lookup table
+void USplineFollowerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SplineLookupTable.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Get the position on the spline that is closest to the actor of this component
 FVector USplineFollowerComponent::GetClosestPositionOnSpline(uint8* ClosestKey)
 {
 	ASSERT_RETURN_VALUE(SplineComponent != nullptr, FVector::ZeroVector);
+	ASSERT_RETURN_VALUE(SplineLookupTable.IsValid(), FVector::ZeroVector, "Spline lookup table requested before BeginPlay");
 
 	// If we want the key
 	if (ClosestKey != nullptr)
 	{
-		float Key = SplineComponent->FindInputKeyClosestToWorldLocation(GetOwner()->GetActorLocation());
-		*ClosestKey = static_cast<uint8>(FMath::RoundHalfFromZero(Key));
+		*ClosestKey = SplineLookupTable->FindPointClosestToWorldLocation(GetOwner()->GetActorLocation(), LastClosestKey);
+		LastClosestKey = *ClosestKey;
 		return SplineComponent->GetLocationAtSplinePoint(*ClosestKey, ESplineCoordinateSpace::World);
 	}
 
-	return SplineComponent->FindLocationClosestToWorldLocation(GetOwner()->GetActorLocation(), ESplineCoordinateSpace::World);
+	FVector ClosestLocation;
+	LastClosestKey = SplineLookupTable->FindInputKeyClosestToWorldLocation(GetOwner()->GetActorLocation(), &ClosestLocation, LastClosestKey);
+	return ClosestLocation;
 }
 
 // Advance the follower to the next point on the spline
@@ -64,6 +77,8 @@ void USplineFollowerComponent::AdvanceToNextPatrolPoint()
 // Get the spline point index that is closest to the actor of this compoennt
 uint8 USplineFollowerComponent::GetClosestPoint()
 {
-	ASSERT_RETURN_VALUE(SplineComponent != nullptr, 0);
-	return FMath::RoundHalfFromZero(SplineComponent->FindInputKeyClosestToWorldLocation(GetOwner()->GetActorLocation()));
+	ASSERT_RETURN_VALUE(SplineLookupTable.IsValid(), 0);
+	const uint8 ClosestPoint = SplineLookupTable->FindPointClosestToWorldLocation(GetOwner()->GetActorLocation(), LastClosestKey);
+	LastClosestKey = ClosestPoint;
+	return ClosestPoint;
 }
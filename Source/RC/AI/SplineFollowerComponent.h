@@ -40,6 +40,9 @@ private:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Release the spline lookup table
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Get the spline point index that is closest to the actor of this compoennt
 	uint8 GetClosestPoint();
 
@@ -48,6 +51,12 @@ private:
 	FComponentReference SplineComponentRef;
 	class USplineComponent* SplineComponent;
 
+	// Precomputed lookup for the spline, shared with other followers on the same spline
+	TSharedPtr<const class FSplineLookupTable> SplineLookupTable;
+
+	// The input key that was closest to the actor last time, to start the next search from. Negative if it hasn't been searched yet
+	float LastClosestKey = -1.0f;
+
 	// Current target index
 	uint8 CurrentTargetPoint = 0;
 
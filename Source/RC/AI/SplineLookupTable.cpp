@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "SplineLookupTable.h"
+
+#include "Components/SplineComponent.h"
+
+#include "RC/Debug/Debug.h"
+
+const int32 FSplineLookupTable::SamplesPerSegment = 8;
+
+// Tables currently in use, keyed by the spline they were baked from
+static TMap<TWeakObjectPtr<const USplineComponent>, TWeakPtr<const FSplineLookupTable>> LookupTables;
+
+// Get the lookup table for the spline, baking it if no one else is using it yet
+TSharedPtr<const FSplineLookupTable> FSplineLookupTable::FindOrCreate(const USplineComponent& Spline)
+{
+	TWeakPtr<const FSplineLookupTable>* ExistingTable = LookupTables.Find(&Spline);
+	if (ExistingTable != nullptr)
+	{
+		TSharedPtr<const FSplineLookupTable> Table = ExistingTable->Pin();
+		if (Table.IsValid())
+		{
+			return Table;
+		}
+	}
+
+	// Clear out any tables that were released or whose spline has gone away
+	for (auto Iter = LookupTables.CreateIterator(); Iter; ++Iter)
+	{
+		if (!Iter.Key().IsValid() || !Iter.Value().IsValid())
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+
+	TSharedPtr<const FSplineLookupTable> Table = MakeShareable(new FSplineLookupTable(Spline));
+	LookupTables.Add(&Spline, Table);
+	return Table;
+}
+
+// Bake the spline into samples
+FSplineLookupTable::FSplineLookupTable(const USplineComponent& InSpline)
+	: Spline(&InSpline)
+{
+	NumPoints = InSpline.GetNumberOfSplinePoints();
+	if (NumPoints == 0)
+	{
+		return;
+	}
+
+	const int32 NumSegments = InSpline.IsClosedLoop() ? NumPoints : NumPoints - 1;
+	const int32 NumSamples = NumSegments * SamplesPerSegment + 1;
+	SampleLocations.Reserve(NumSamples);
+	SampleKeys.Reserve(NumSamples);
+	Segments.Reserve(NumSegments);
+
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const float Key = static_cast<float>(SampleIndex) / SamplesPerSegment;
+		SampleKeys.Add(Key);
+		SampleLocations.Add(InSpline.GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::Local));
+	}
+
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		FSegment& Segment = Segments.AddDefaulted_GetRef();
+		Segment.FirstSample = SegmentIndex * SamplesPerSegment;
+		Segment.Bounds = FBox(&SampleLocations[Segment.FirstSample], SamplesPerSegment + 1);
+	}
+}
+
+// Find the input key on the spline closest to a world location
+float FSplineLookupTable::FindInputKeyClosestToWorldLocation(const FVector& WorldLocation, FVector* OutLocation/* = nullptr*/, float HintKey/* = -1.0f*/) const
+{
+	const FTransform SplineTransform = GetSplineTransform();
+	if (Segments.Num() == 0)
+	{
+		if (OutLocation != nullptr)
+		{
+			*OutLocation = SampleLocations.Num() != 0 ? SplineTransform.TransformPosition(SampleLocations[0]) : SplineTransform.GetLocation();
+		}
+		return 0;
+	}
+
+	// Search in the spline's space with only its scale applied, so the samples don't need moving with it
+	// and distances still match world distances when the scale isn't uniform
+	const FVector Scale = SplineTransform.GetScale3D();
+	const FVector ScaledLocation = SplineTransform.GetRotation().UnrotateVector(WorldLocation - SplineTransform.GetLocation());
+
+	float BestDistanceSqr = TNumericLimits<float>::Max();
+	float BestKey = 0;
+	FVector BestLocation = SampleLocations[0];
+	auto SearchSegment = [&](const FSegment& Segment)
+	{
+		for (int32 SampleIndex = Segment.FirstSample; SampleIndex < Segment.FirstSample + SamplesPerSegment; ++SampleIndex)
+		{
+			const FVector Start = SampleLocations[SampleIndex] * Scale;
+			const FVector Span = SampleLocations[SampleIndex + 1] * Scale - Start;
+			const float SpanSizeSqr = Span.SizeSquared();
+			const float Alpha = SpanSizeSqr > SMALL_NUMBER ? FMath::Clamp(FVector::DotProduct(ScaledLocation - Start, Span) / SpanSizeSqr, 0.0f, 1.0f) : 0.0f;
+
+			const float DistanceSqr = FVector::DistSquared(ScaledLocation, Start + Span * Alpha);
+			if (DistanceSqr < BestDistanceSqr)
+			{
+				BestDistanceSqr = DistanceSqr;
+				BestKey = FMath::Lerp(SampleKeys[SampleIndex], SampleKeys[SampleIndex + 1], Alpha);
+				BestLocation = FMath::Lerp(SampleLocations[SampleIndex], SampleLocations[SampleIndex + 1], Alpha);
+			}
+		}
+	};
+
+	// Start from the hinted segment, which is usually still the closest, so most of the others can be skipped by their bounds
+	const int32 HintSegment = HintKey >= 0 ? FMath::Clamp(FMath::FloorToInt(HintKey), 0, Segments.Num() - 1) : INDEX_NONE;
+	if (HintSegment != INDEX_NONE)
+	{
+		SearchSegment(Segments[HintSegment]);
+	}
+
+	for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); ++SegmentIndex)
+	{
+		if (SegmentIndex == HintSegment)
+		{
+			continue;
+		}
+
+		// A negative scale flips the bounds, so take the min and max again once scaled
+		const FBox& Bounds = Segments[SegmentIndex].Bounds;
+		const FVector ScaledMin = Bounds.Min * Scale;
+		const FVector ScaledMax = Bounds.Max * Scale;
+		const FBox ScaledBounds(ScaledMin.ComponentMin(ScaledMax), ScaledMin.ComponentMax(ScaledMax));
+		if (ScaledBounds.ComputeSquaredDistanceToPoint(ScaledLocation) < BestDistanceSqr)
+		{
+			SearchSegment(Segments[SegmentIndex]);
+		}
+	}
+
+	if (OutLocation != nullptr)
+	{
+		*OutLocation = SplineTransform.TransformPosition(BestLocation);
+	}
+	return BestKey;
+}
+
+// Find the spline point closest to a world location
+uint8 FSplineLookupTable::FindPointClosestToWorldLocation(const FVector& WorldLocation, float HintKey/* = -1.0f*/) const
+{
+	if (NumPoints == 0)
+	{
+		return 0;
+	}
+
+	// The end of a closed loop wraps back to the first point
+	const int32 Point = FMath::RoundHalfFromZero(FindInputKeyClosestToWorldLocation(WorldLocation, nullptr, HintKey));
+	return static_cast<uint8>(Point % NumPoints);
+}
+
+// Get the transform from the spline's local space to world space
+FTransform FSplineLookupTable::GetSplineTransform() const
+{
+	const USplineComponent* SplineComponent = Spline.Get();
+	return SplineComponent != nullptr ? SplineComponent->GetComponentTransform() : FTransform::Identity;
+}
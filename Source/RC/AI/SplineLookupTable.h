@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Precomputed samples of a patrol spline so closest point queries don't need to iterate every segment.
+ * Tables are shared between every follower on the same spline and released once the last follower lets go.
+ * Samples are baked in the spline's local space so the table stays valid when the spline moves,
+ * and are compared with the spline's scale applied so the closest point is right even when the scale isn't uniform
+ */
+class RC_API FSplineLookupTable
+{
+public:
+	/**
+	 * Get the lookup table for the spline, baking it if no one else is using it yet
+	 *
+	 * @param Spline	The spline to get the table for
+	 * Returns the shared table
+	 */
+	static TSharedPtr<const FSplineLookupTable> FindOrCreate(const USplineComponent& Spline);
+
+	/**
+	 * Find the input key on the spline closest to a world location
+	 *
+	 * @param WorldLocation	The location to test against
+	 * @param OutLocation	The closest location on the spline
+	 * @param HintKey		The input key that was closest last time, negative if there isn't one. Its segment is searched first
+	 * Returns the closest input key
+	 */
+	float FindInputKeyClosestToWorldLocation(const FVector& WorldLocation, FVector* OutLocation = nullptr, float HintKey = -1.0f) const;
+
+	/**
+	 * Find the spline point closest to a world location
+	 *
+	 * @param WorldLocation	The location to test against
+	 * @param HintKey		The input key that was closest last time, negative if there isn't one. Its segment is searched first
+	 * Returns the index of the closest spline point
+	 */
+	uint8 FindPointClosestToWorldLocation(const FVector& WorldLocation, float HintKey = -1.0f) const;
+
+	// Get the number of spline points that were baked
+	int32 GetNumberOfPoints() const { return NumPoints; }
+
+private:
+	// Bake the spline into samples
+	explicit FSplineLookupTable(const USplineComponent& InSpline);
+
+	/**
+	 * A segment between 2 spline points
+	 */
+	struct FSegment
+	{
+		// Bounds of every sample in the segment, in the spline's local space
+		FBox Bounds;
+
+		// Index of the first sample, the segment owns this sample through the first sample of the next segment
+		int32 FirstSample = 0;
+	};
+
+	// Get the transform from the spline's local space to world space
+	FTransform GetSplineTransform() const;
+
+	// Number of samples to bake between each spline point
+	static const int32 SamplesPerSegment;
+
+	// The spline the table was baked from
+	TWeakObjectPtr<const USplineComponent> Spline;
+
+	// Segments of the spline
+	TArray<FSegment> Segments;
+
+	// Location of each sample in the spline's local space
+	TArray<FVector> SampleLocations;
+
+	// Input key of each sample
+	TArray<float> SampleKeys;
+
+	// Number of points on the spline
+	int32 NumPoints = 0;
+};
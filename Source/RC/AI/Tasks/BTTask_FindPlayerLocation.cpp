@@ -4,11 +4,10 @@
 
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "BehaviorTree/BlackboardComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "NavigationSystem.h"
 
 #include "RC/AI/BaseAIController.h"
 #include "RC/AI/BlackBoardKeys.h"
+#include "RC/AI/PlayerNavigationSubsystem.h"
 #include "RC/Debug/Debug.h"
 
 UBTTask_FindPlayerLocation::UBTTask_FindPlayerLocation(const FObjectInitializer& ObjectInitializer)
@@ -22,19 +21,17 @@ EBTNodeResult::Type UBTTask_FindPlayerLocation::ExecuteTask(UBehaviorTreeCompone
 	UBlackboardComponent* BlackBoardComponent = OwnerComponent.GetBlackboardComponent();
 	ASSERT_RETURN_VALUE(BlackBoardComponent != nullptr, EBTNodeResult::Failed);
 
-	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
-	ASSERT_RETURN_VALUE(Player != nullptr, EBTNodeResult::Failed);
-	
 	AAIController* AIController = OwnerComponent.GetAIOwner();
 	ASSERT_RETURN_VALUE(AIController != nullptr, EBTNodeResult::Failed);
 	const FNavAgentProperties& AgentProps = AIController->GetNavAgentPropertiesRef();
 
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-	ASSERT_RETURN_VALUE(NavSys != nullptr, EBTNodeResult::Failed);
+	UPlayerNavigationSubsystem* PlayerNavigation = GetWorld()->GetSubsystem<UPlayerNavigationSubsystem>();
+	ASSERT_RETURN_VALUE(PlayerNavigation != nullptr, EBTNodeResult::Failed);
 
+	// The projection is shared with every other AI asking this frame
 	FNavLocation ProjectedLocation;
 	EBTNodeResult::Type Result = EBTNodeResult::Failed;
-	if (NavSys && NavSys->ProjectPointToNavigation(Player->GetActorLocation(), ProjectedLocation, INVALID_NAVEXTENT, &AgentProps))
+	if (PlayerNavigation->GetPlayerNavLocation(AgentProps, ProjectedLocation))
 	{
 		BlackBoardComponent->SetValue<UBlackboardKeyType_Vector>(BlackboardKey.GetSelectedKeyID(), ProjectedLocation);
 		Result = EBTNodeResult::Succeeded;
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "BTTask_FollowChaseFlowField.h"
+
+#include "AIController.h"
+#include "Kismet/GameplayStatics.h"
+
+#include "RC/AI/ChaseFlowFieldSubsystem.h"
+#include "RC/Debug/Debug.h"
+
+UBTTask_FollowChaseFlowField::UBTTask_FollowChaseFlowField(const FObjectInitializer& ObjectInitializer)
+{
+	NodeName = TEXT("Follow Chase Flow Field");
+	bNotifyTick = true;
+}
+
+// Start steering towards the player
+EBTNodeResult::Type UBTTask_FollowChaseFlowField::ExecuteTask(UBehaviorTreeComponent& OwnerComponent, uint8* NodeMemory)
+{
+	return Steer(OwnerComponent);
+}
+
+// Keep steering towards the player
+void UBTTask_FollowChaseFlowField::TickTask(UBehaviorTreeComponent& OwnerComponent, uint8* NodeMemory, float DeltaSeconds)
+{
+	EBTNodeResult::Type Result = Steer(OwnerComponent);
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(OwnerComponent, Result);
+	}
+}
+
+// Steer the pawn along the field
+EBTNodeResult::Type UBTTask_FollowChaseFlowField::Steer(UBehaviorTreeComponent& OwnerComponent) const
+{
+	AAIController* AIController = OwnerComponent.GetAIOwner();
+	ASSERT_RETURN_VALUE(AIController != nullptr, EBTNodeResult::Failed);
+
+	APawn* Pawn = AIController->GetPawn();
+	ASSERT_RETURN_VALUE(Pawn != nullptr, EBTNodeResult::Failed);
+
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	ASSERT_RETURN_VALUE(Player != nullptr, EBTNodeResult::Failed);
+
+	// Close enough
+	if (FVector::DistSquared2D(Pawn->GetActorLocation(), Player->GetActorLocation()) <= FMath::Square(AcceptableRadius))
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	UChaseFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UChaseFlowFieldSubsystem>();
+	ASSERT_RETURN_VALUE(FlowField != nullptr, EBTNodeResult::Failed);
+
+	FVector Direction;
+	if (!FlowField->GetChaseDirection(AIController->GetNavAgentPropertiesRef(), Pawn->GetNavAgentLocation(), Direction))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	Pawn->AddMovementInput(Direction);
+	return EBTNodeResult::InProgress;
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+
+#include "BTTask_FollowChaseFlowField.generated.h"
+
+/**
+ * Steer towards the player using the shared chase flow field instead of requesting a path.
+ * Fails if the AI is outside the field so it can fall back to a regular move to
+ */
+UCLASS()
+class RC_API UBTTask_FollowChaseFlowField : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_FollowChaseFlowField(const FObjectInitializer& ObjectInitializer);
+	EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComponent, uint8* NodeMemory) override;
+
+protected:
+	void TickTask(UBehaviorTreeComponent& OwnerComponent, uint8* NodeMemory, float DeltaSeconds) override;
+
+	// How close to the player the AI needs to get to succeed
+	UPROPERTY(EditAnywhere, Category = AI, meta = (ClampMin = "0.0"))
+	float AcceptableRadius = 200.0f;
+
+private:
+	/**
+	 * Steer the pawn along the field
+	 * Returns the result if the task has finished, or InProgress
+	 */
+	EBTNodeResult::Type Steer(UBehaviorTreeComponent& OwnerComponent) const;
+};
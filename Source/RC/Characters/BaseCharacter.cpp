@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "BaseCharacter.h"
 
+#include "Animation/AnimInstance.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -9,6 +10,8 @@
 #include "RC/Characters/Components/HealthComponent.h"
 #include "RC/Characters/Components/StatusEffectComponent.h"
 #include "RC/Characters/Player/RCCharacter.h"
+#include "RC/Characters/RagdollSubsystem.h"
+#include "RC/Framework/DamageableGridSubsystem.h"
 #include "RC/Util/RCStatics.h"
 
 ABaseCharacter::ABaseCharacter()
@@ -35,6 +38,42 @@ void ABaseCharacter::Serialize(FArchive& Ar)
 	}
 }
 
+// Start being tracked as a damageable target
+void ABaseCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	SetTrackedAsDamageable(true);
+}
+
+// Stop being tracked as a damageable target
+void ABaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	SetTrackedAsDamageable(false);
+}
+
+// Set whether this character can be found by damageable target queries
+void ABaseCharacter::SetTrackedAsDamageable(bool bTracked)
+{
+	UWorld* World = GetWorld();
+	UDamageableGridSubsystem* DamageableGrid = World != nullptr ? World->GetSubsystem<UDamageableGridSubsystem>() : nullptr;
+	if (DamageableGrid == nullptr)
+	{
+		return;
+	}
+
+	if (bTracked)
+	{
+		DamageableGrid->RegisterDamageable(*this);
+	}
+	else
+	{
+		DamageableGrid->UnregisterDamageable(*this);
+	}
+}
+
 // Request for this character to be damaged
 void ABaseCharacter::RequestDamage(FDamageRequestParams& Params)
 {
@@ -90,6 +129,9 @@ bool ABaseCharacter::IsDead() const
 // Called when the character dies
 void ABaseCharacter::OnActorDied(AActor* Actor)
 {
+	// The body isn't a target anymore
+	SetTrackedAsDamageable(false);
+
 	// Disable all collision on capsule
 	UCapsuleComponent* Capsule = GetCapsuleComponent();
 	if (Capsule != nullptr)
@@ -116,13 +158,30 @@ void ABaseCharacter::OnActorDied(AActor* Actor)
 
 	if (!bIsRagdolling)
 	{
-		// Ragdoll
-		if (SkeletalMesh != nullptr)
+		// Ragdoll if there's room in the budget, otherwise fall back to the death montage.
+		// The player's body isn't budgeted so it's never frozen or evicted for an enemy's
+		URagdollSubsystem* RagdollSubsystem = !URCStatics::IsActorPlayer(this) && GetWorld() != nullptr ? GetWorld()->GetSubsystem<URagdollSubsystem>() : nullptr;
+		if (RagdollSubsystem == nullptr || RagdollSubsystem->RequestRagdoll(*this))
 		{
-			SkeletalMesh->SetAllBodiesSimulatePhysics(true);
-			SkeletalMesh->SetSimulatePhysics(true);
-			SkeletalMesh->WakeAllRigidBodies();
-			SkeletalMesh->bBlendPhysics = true;
+			if (SkeletalMesh != nullptr)
+			{
+				SkeletalMesh->SetAllBodiesSimulatePhysics(true);
+				SkeletalMesh->SetSimulatePhysics(true);
+				SkeletalMesh->WakeAllRigidBodies();
+				SkeletalMesh->bBlendPhysics = true;
+			}
+
+			bIsRagdolling = true;
+		}
+		else
+		{
+			// Without a montage the body is held in the pose it died in
+			UAnimInstance* AnimInstance = GetAnimInstance();
+			const bool bPlayedMontage = DeathMontage != nullptr && AnimInstance != nullptr && AnimInstance->Montage_Play(DeathMontage) > 0.0f;
+			if (!bPlayedMontage)
+			{
+				FreezeRagdoll();
+			}
 		}
 
 		// Stop any movement
@@ -137,7 +196,84 @@ void ABaseCharacter::OnActorDied(AActor* Actor)
 		{
 			LOG_CHECK(Movement != nullptr, LogActor, Error, "Character %s doesn't have a movment component", *GetName());
 		}
+	}
+
+	// Clean up the body after a while
+	SetLifeSpan(CorpseLifeSpan);
+}
 
-		bIsRagdolling = true;
+// Stop the ragdoll simulating, holding the body in its current pose
+void ABaseCharacter::FreezeRagdoll()
+{
+	USkeletalMeshComponent* SkeletalMesh = GetMesh();
+	ASSERT_RETURN(SkeletalMesh != nullptr);
+
+	// With the mesh no longer ticking the bones stay where physics left them
+	SkeletalMesh->SetAllBodiesSimulatePhysics(false);
+	SkeletalMesh->SetSimulatePhysics(false);
+	SkeletalMesh->SetComponentTickEnabled(false);
+	SkeletalMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
+
+// Bring the character back to life, undoing the ragdoll and clearing any status effects
+void ABaseCharacter::ResetCharacter()
+{
+	const ABaseCharacter* DefaultCharacter = GetClass()->GetDefaultObject<ABaseCharacter>();
+	ASSERT_RETURN(DefaultCharacter != nullptr);
+
+	// Don't let the corpse timer destroy us
+	SetLifeSpan(0);
+
+	URagdollSubsystem* RagdollSubsystem = GetWorld() != nullptr ? GetWorld()->GetSubsystem<URagdollSubsystem>() : nullptr;
+	if (RagdollSubsystem != nullptr)
+	{
+		RagdollSubsystem->RemoveCorpse(*this);
+	}
+
+	if (StatusEffect != nullptr)
+	{
+		StatusEffect->RemoveAllStatusEffects();
+	}
+
+	if (Health != nullptr)
+	{
+		Health->ResetHealth();
 	}
+
+	UAnimInstance* AnimInstance = GetAnimInstance();
+	if (AnimInstance != nullptr && DeathMontage != nullptr)
+	{
+		AnimInstance->Montage_Stop(0.0f, DeathMontage);
+	}
+
+	// Restore the capsule collision
+	UCapsuleComponent* Capsule = GetCapsuleComponent();
+	if (Capsule != nullptr && DefaultCharacter->GetCapsuleComponent() != nullptr)
+	{
+		Capsule->SetCollisionProfileName(DefaultCharacter->GetCapsuleComponent()->GetCollisionProfileName());
+	}
+
+	// Take the mesh out of ragdoll and put it back on the capsule
+	USkeletalMeshComponent* SkeletalMesh = GetMesh();
+	const USkeletalMeshComponent* DefaultMesh = DefaultCharacter->GetMesh();
+	if (SkeletalMesh != nullptr && DefaultMesh != nullptr)
+	{
+		SkeletalMesh->SetAllBodiesSimulatePhysics(false);
+		SkeletalMesh->SetSimulatePhysics(false);
+		SkeletalMesh->bBlendPhysics = false;
+		SkeletalMesh->SetComponentTickEnabled(true);
+		SkeletalMesh->SetCollisionProfileName(DefaultMesh->GetCollisionProfileName());
+		SkeletalMesh->AttachToComponent(Capsule, FAttachmentTransformRules::KeepRelativeTransform);
+		SkeletalMesh->SetRelativeLocationAndRotation(DefaultMesh->GetRelativeLocation(), DefaultMesh->GetRelativeRotation(), false, nullptr, ETeleportType::ResetPhysics);
+	}
+
+	// Let them move again
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	if (Movement != nullptr)
+	{
+		Movement->SetComponentTickEnabled(true);
+		Movement->SetDefaultMovementMode();
+	}
+
+	bIsRagdolling = false;
 }
@@ -54,7 +54,28 @@ public:
 	// Returns the anim instance
 	FORCEINLINE class UAnimInstance* GetAnimInstance() const { return GetMesh() != nullptr ? GetMesh()->GetAnimInstance() : nullptr; }
 
+	// Bring the character back to life, undoing the ragdoll and clearing any status effects
+	virtual void ResetCharacter();
+
+	// Stop the ragdoll simulating, holding the body in its current pose
+	void FreezeRagdoll();
+
+	// Clean up the body now instead of waiting for the corpse lifespan
+	void ReleaseCorpse() { LifeSpanExpired(); }
+
+	/**
+	 * Set whether this character can be found by damageable target queries
+	 * @param bTracked	Whether the character should be tracked
+	 */
+	void SetTrackedAsDamageable(bool bTracked);
+
 protected:
+	// Start being tracked as a damageable target
+	void BeginPlay() override;
+
+	// Stop being tracked as a damageable target
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * Called when the character dies
 	 * @param Actor	The actor that's died
@@ -75,5 +96,13 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = XP, meta = (AllowPrivateAccess = "true"))
 	float XPForKilling = 0;
 
+	// How long the body stays around after dying
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Health, meta = (AllowPrivateAccess = "true"))
+	float CorpseLifeSpan = 5;
+
+	// Montage to play on death when there are too many ragdolls simulating. Without one the body holds the pose it died in
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Health, meta = (AllowPrivateAccess = "true"))
+	class UAnimMontage* DeathMontage = nullptr;
+
 	bool bIsRagdolling = false;
 };
@@ -80,6 +80,14 @@ void UHealthComponent::OnKilled()
 	bIsDead = true;
 
 	ActorDiedDelegate.Broadcast(GetOwner());
+}
 
-	GetOwner()->SetLifeSpan(5);
+// Bring the actor back to full health and alive
+void UHealthComponent::ResetHealth()
+{
+	float PreviousHealth = CurrentHealth;
+	CurrentHealth = MaxHealth;
+	bIsDead = false;
+
+	ActorHealthChangedDelegate.Broadcast(GetOwner(), PreviousHealth, CurrentHealth);
 }
@@ -33,6 +33,10 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsDead() const { return bIsDead; }
 
+	// Get the current health as a fraction of the max
+	UFUNCTION(BlueprintPure)
+	float GetHealthFraction() const { return MaxHealth > 0 ? static_cast<float>(CurrentHealth) / MaxHealth : 0.0f; }
+
 	/**
 	 * Apply damage requested
 	 * @param DamageParams	Params for the damage to apply
@@ -45,6 +49,9 @@ public:
 	// Grant the given amount of health
 	void GrantHealth(int Amount);
 
+	// Bring the actor back to full health and alive
+	void ResetHealth();
+
 	// Get the Actor Health Changed delegate
 	FOnActorHealthChanged& OnActorHealthChanged() { return ActorHealthChangedDelegate; }
 
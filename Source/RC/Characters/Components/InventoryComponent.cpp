@@ -44,10 +44,10 @@ void UInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// Destroy the spawned weapon
-	if (EquippedWeapon != nullptr)
+	// Destroy the spawned weapons
+	for (uint8 SlotIndex = 0; SlotIndex < MAX_WEAPONS; ++SlotIndex)
 	{
-		EquippedWeapon->Destroy();
+		DestroySlotWeapon(static_cast<EInventorySlot>(SlotIndex));
 	}
 }
 
@@ -56,10 +56,13 @@ void UInventoryComponent::AssignSlot(EInventorySlot Slot, const FPrimaryAssetId&
 {
 	ASSERT_RETURN(Slot != EInventorySlot::NUM_SLOTS);
 
+	// The old weapon won't be used anymore
+	DestroySlotWeapon(Slot);
+
 	Weapons[static_cast<uint8>(Slot)].AssetId = WeaponInfoId;
 	Weapons[static_cast<uint8>(Slot)].WeaponInfo = nullptr;
 	
-	Weapons[static_cast<uint8>(Slot)].StreamHandle = URCStatics::LoadPrimaryAsset(WeaponInfoId, FStreamableDelegate::CreateUObject(this, &UInventoryComponent::OnWeaponInfoLoaded, Slot));
+	Weapons[static_cast<uint8>(Slot)].StreamHandle = URCStatics::LoadPrimaryAsset(WeaponInfoId, FStreamableDelegate::CreateUObject(this, &UInventoryComponent::OnWeaponInfoLoaded, Slot), { UPlayerWeaponInfo::UIBundle });
 }
 
 // Called once the weapon info has been loaded
@@ -88,6 +91,11 @@ void UInventoryComponent::OnWeaponInfoLoaded(EInventorySlot Slot)
 		EquippedSlot = EInventorySlot::NUM_SLOTS;
 		EquipSlot(Slot);
 	}
+	else
+	{
+		// Spawn it now so the first swap to it doesn't hitch
+		FindOrSpawnSlot(Slot);
+	}
 }
 
 // Equip a slot as the current weapon. If there's no weapon in that slot, then it won't equip
@@ -105,24 +113,15 @@ ABasePlayerWeapon* UInventoryComponent::EquipSlot(EInventorySlot NewSlot)
 		return nullptr;
 	}
 
-	AActor* Owner = GetOwner();
-	ASSERT_RETURN_VALUE(Owner != nullptr, nullptr);
-
-	ARCCharacter* Player = Cast<ARCCharacter>(Owner);
-	ASSERT_RETURN_VALUE(Player != nullptr, nullptr, "Inventory isn't on the player?");
+	ABasePlayerWeapon* NewWeapon = FindOrSpawnSlot(NewSlot);
+	ASSERT_RETURN_VALUE(NewWeapon != nullptr, nullptr, "New weapon wasn't able to be spawned");
 
-	// * TODO *
-	// delete old weapon
+	// Put away the old weapon
 	if (EquippedWeapon != nullptr)
 	{
-		// Rename so we can name the new weapon
-		EquippedWeapon->Rename();
-		EquippedWeapon->Destroy();
+		EquippedWeapon->SetEquipped(false);
 	}
 
-	ABasePlayerWeapon* NewWeapon = SpawnSlot(NewSlot);
-	ASSERT_RETURN_VALUE(NewWeapon != nullptr, nullptr, "New weapon wasn't able to be spawned");
-
 	EquippedWeapon = NewWeapon;
 	if (EquippedSlot != EInventorySlot::SlotWrench)
 	{
@@ -130,8 +129,7 @@ ABasePlayerWeapon* UInventoryComponent::EquipSlot(EInventorySlot NewSlot)
 	}
 	EquippedSlot = NewSlot;
 
-	// Tell weapon who the owner is
-	EquippedWeapon->SetWielder(Player);
+	EquippedWeapon->SetEquipped(true);
 
 	WeaponEquippedDelegate.Broadcast(EquippedWeapon, EquippedSlot);
 
@@ -264,11 +262,19 @@ bool UInventoryComponent::IsSlotOccupied(EInventorySlot Slot) const
 	return (Slot != EInventorySlot::NUM_SLOTS) && (Weapons[static_cast<uint8>(Slot)].IsValid());
 }
 
-// Spawn the weapon from the slot
-ABasePlayerWeapon* UInventoryComponent::SpawnSlot(EInventorySlot NewSlot)
+// Get the weapon spawned for the given slot, spawning it put away if it hasn't been yet
+ABasePlayerWeapon* UInventoryComponent::FindOrSpawnSlot(EInventorySlot Slot)
 {
+	ASSERT_RETURN_VALUE(Slot != EInventorySlot::NUM_SLOTS, nullptr);
+
+	FInventoryWeapon& InventoryWeapon = Weapons[static_cast<uint8>(Slot)];
+	if (InventoryWeapon.SpawnedWeapon != nullptr)
+	{
+		return InventoryWeapon.SpawnedWeapon;
+	}
+
 	TSubclassOf<class ABaseWeapon> WeaponClass = NULL;
-	if (!GetWeaponClass(WeaponClass, NewSlot))
+	if (!GetWeaponClass(WeaponClass, Slot))
 	{
 		return nullptr;
 	}
@@ -276,16 +282,43 @@ ABasePlayerWeapon* UInventoryComponent::SpawnSlot(EInventorySlot NewSlot)
 	UWorld* World = GetWorld();
 	ASSERT_RETURN_VALUE(World != nullptr, nullptr);
 
-	AActor* Owner = GetOwner();
-	ASSERT_RETURN_VALUE(Owner != nullptr, nullptr);
+	ARCCharacter* Player = GetOwner<ARCCharacter>();
+	ASSERT_RETURN_VALUE(Player != nullptr, nullptr, "Inventory isn't on the player?");
 
 	FActorSpawnParameters SpawnParams;
-	SpawnParams.Name = TEXT("CurrentWeapon");
-	SpawnParams.Owner = Owner;
-	SpawnParams.Instigator = Cast<APawn>(Owner);
+	SpawnParams.Owner = Player;
+	SpawnParams.Instigator = Player;
 	SpawnParams.bNoFail = true;
 
 	FTransform SpawnTransform = FTransform::Identity;
 
-	return World->SpawnActor<ABasePlayerWeapon>(WeaponClass, SpawnTransform, SpawnParams);
-}
\ No newline at end of file
+	ABasePlayerWeapon* Weapon = World->SpawnActor<ABasePlayerWeapon>(WeaponClass, SpawnTransform, SpawnParams);
+	ASSERT_RETURN_VALUE(Weapon != nullptr, nullptr);
+
+	// Tell weapon who the owner is
+	Weapon->SetWielder(Player);
+	Weapon->SetEquipped(false);
+
+	InventoryWeapon.SpawnedWeapon = Weapon;
+	return Weapon;
+}
+
+// Destroy the weapon spawned for the given slot
+void UInventoryComponent::DestroySlotWeapon(EInventorySlot Slot)
+{
+	ASSERT_RETURN(Slot != EInventorySlot::NUM_SLOTS);
+
+	FInventoryWeapon& InventoryWeapon = Weapons[static_cast<uint8>(Slot)];
+	if (InventoryWeapon.SpawnedWeapon == nullptr)
+	{
+		return;
+	}
+
+	if (InventoryWeapon.SpawnedWeapon == EquippedWeapon)
+	{
+		EquippedWeapon = nullptr;
+	}
+
+	InventoryWeapon.SpawnedWeapon->Destroy();
+	InventoryWeapon.SpawnedWeapon = nullptr;
+}
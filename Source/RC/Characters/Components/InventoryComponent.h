@@ -34,6 +34,10 @@ struct FInventoryWeapon
 	// Cached weapon info
 	const class UPlayerWeaponInfo* WeaponInfo = nullptr;
 
+	// The spawned weapon, kept around while it isn't equipped so swapping back doesn't need to spawn it again
+	UPROPERTY(Transient)
+	class ABasePlayerWeapon* SpawnedWeapon = nullptr;
+
 	bool IsValid() const { return WeaponInfo != nullptr; }
 };
 
@@ -181,6 +185,9 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsSlotOccupied(EInventorySlot Slot) const;
 
+	// Get the loadout the player spawns with
+	const FLoadout& GetDefaultLoadout() const { return DefaultLoadout; }
+
 	// Get the Weapon Equipped delegate
 	FOnWeaponEquipped& OnWeaponEquipped() { return WeaponEquippedDelegate; }
 
@@ -200,12 +207,19 @@ private:
 	void OnWeaponInfoLoaded(EInventorySlot Slot);
 
 	/**
-	 * Spawn the weapon in the given slot
+	 * Get the weapon spawned for the given slot, spawning it put away if it hasn't been yet
 	 *
 	 * @Param Slot	The slot to get the weapon class to spawn with
-	 * @Return The spawaned weapon
+	 * @Return The spawned weapon
+	 */
+	class ABasePlayerWeapon* FindOrSpawnSlot(EInventorySlot Slot);
+
+	/**
+	 * Destroy the weapon spawned for the given slot
+	 *
+	 * @Param Slot	The slot to destroy the weapon of
 	 */
-	class ABasePlayerWeapon* SpawnSlot(EInventorySlot NewSlot);
+	void DestroySlotWeapon(EInventorySlot Slot);
 
 	// The loadout to spawn the player with
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Loadout, meta = (AllowPrivateAccess = "true"))
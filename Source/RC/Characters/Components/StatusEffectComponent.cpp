@@ -108,6 +108,22 @@ void UStatusEffectComponent::RemoveStatusEffectTimed(const TSubclassOf<UBaseStat
 	}
 }
 
+// Remove every stack of every status effect
+void UStatusEffectComponent::RemoveAllStatusEffects()
+{
+	for (FStatusEffect& StatusEffect : ActiveStatusEffects)
+	{
+		StatusEffect.RemoveAllStacks();
+	}
+	ActiveStatusEffects.Empty();
+
+	for (FStatusEffectTimed& StatusEffect : ActiveTimedStatusEffects)
+	{
+		StatusEffect.RemoveAllStacks();
+	}
+	ActiveTimedStatusEffects.Empty();
+}
+
 // Add a stack
 void FStatusEffect::AddStack(EStatusEffectRequestType RequestType)
 {
@@ -147,6 +147,10 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void RemoveStatusEffectTimed(const TSubclassOf<class UBaseStatusEffect> Class);
 
+	// Remove every stack of every status effect
+	UFUNCTION(BlueprintCallable)
+	void RemoveAllStatusEffects();
+
 protected:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
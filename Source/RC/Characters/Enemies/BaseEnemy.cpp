@@ -2,21 +2,43 @@
 #include "BaseEnemy.h"
 
 #include "AIController.h"
+#include "Animation/AnimInstance.h"
 #include "BrainComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 
+#include "RC/AI/BaseAIController.h"
 #include "RC/AI/SplineFollowerComponent.h"
 #include "RC/Characters/Components/HealthComponent.h"
+#include "RC/Characters/Enemies/EnemyPoolSubsystem.h"
 #include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageSubsystem.h"
 #include "RC/Framework/RCGameMode.h"
+#include "RC/Weapons/RCWeaponTypes.h"
+#include "RC/Weapons/Weapons/Components/WeaponComponent.h"
 #include "RC/Weapons/Weapons/EnemyWeapons/BaseEnemyWeapon.h"
 
+const TArray<float> ABaseEnemy::AnimUpdateScreenSizeThresholds = { 0.4f, 0.2f, 0.1f };
+
 // Sets default values
 ABaseEnemy::ABaseEnemy()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
 	SplineFollower = CreateDefaultSubobject<USplineFollowerComponent>(TEXT("Spline Follower"));
+
+	WeaponMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Weapon Mesh"));
+	WeaponMesh->SetupAttachment(GetMesh());
+	WeaponMesh->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+
+	// Throttle the animation by distance and skip it while off screen
+	USkeletalMeshComponent* SkeletalMesh = GetMesh();
+	if (SkeletalMesh != nullptr)
+	{
+		SkeletalMesh->OnAnimUpdateRateParamsCreated.BindUObject(this, &ABaseEnemy::OnAnimUpdateRateParamsCreated);
+	}
 }
 
 // Called when the game starts or when spawned
@@ -32,12 +54,23 @@ void ABaseEnemy::BeginPlay()
 	}
 
 	SetupWeapon();
+
+	// Attacks from the weapon and from the behavior tree both play montages, so follow every montage on the mesh
+	UAnimInstance* AnimInstance = GetAnimInstance();
+	if (AnimInstance != nullptr)
+	{
+		AnimInstance->OnMontageStarted.AddDynamic(this, &ABaseEnemy::OnMontageStarted);
+		AnimInstance->OnMontageEnded.AddDynamic(this, &ABaseEnemy::OnMontageEnded);
+	}
+	UpdateAnimationRate();
 }
 
 // Called before the component is destroyed
-void ABaseEnemy::EndPlay(const EEndPlayReason::Type)
+void ABaseEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Destroy weapon with us
+	Super::EndPlay(EndPlayReason);
+
+	// Destroy weapon with us. A component weapon goes away with us on its own
 	if (Weapon != nullptr)
 	{
 		Weapon->Destroy();
@@ -52,6 +85,17 @@ ABaseWeapon* ABaseEnemy::GetEquippedWeapon() const
 // Attack the player
 void ABaseEnemy::AttackPlayer()
 {
+	if (bWeaponAsComponent)
+	{
+		LOG_RETURN(WeaponComponent != nullptr, LogAI, Error, "Enemy %s doesn't have weapon component", *GetName());
+
+		ABaseCharacter* Player = Cast<ABaseCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+		LOG_RETURN(Player != nullptr, LogAI, Error, "Unable to find Player");
+
+		WeaponComponent->AttackTarget(Player);
+		return;
+	}
+
 	LOG_RETURN(Weapon != nullptr, LogAI, Error, "Enemy %s doesn't have weapon", *GetName());
 	
 	Weapon->AttackPlayer();
@@ -73,6 +117,12 @@ void ABaseEnemy::OnActorDied(AActor* Actor)
 		}
 	}
 
+	// Pooled enemies aren't part of the level so there's nothing to save
+	if (bPooled)
+	{
+		return;
+	}
+
 	// Save that this enemy has died
 	ARCGameMode* GameMode = Cast<ARCGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
 	if (GameMode != nullptr)
@@ -88,6 +138,12 @@ void ABaseEnemy::OnActorDied(AActor* Actor)
 // Spawn and setup the weapon
 void ABaseEnemy::SetupWeapon()
 {
+	if (bWeaponAsComponent)
+	{
+		SetupWeaponComponent();
+		return;
+	}
+
 	UClass* WeaponClassObj = WeaponClass.Get();
 	LOG_RETURN(WeaponClassObj != nullptr, LogAI, Warning, "Enemy %s doesn't have weapon class set", *GetName());
 
@@ -106,4 +162,168 @@ void ABaseEnemy::SetupWeapon()
 	ASSERT_RETURN(Weapon != nullptr);
 
 	Weapon->SetWielder(this);
-}
\ No newline at end of file
+}
+
+// Setup the weapon component and mesh living on this enemy
+void ABaseEnemy::SetupWeaponComponent()
+{
+	LOG_RETURN(WeaponInfo != nullptr, LogAI, Warning, "Enemy %s doesn't have weapon info set", *GetName());
+	ASSERT_RETURN(WeaponMesh != nullptr);
+
+	// Find the weapon component added in blueprint
+	TInlineComponentArray<UWeaponComponent*> WeaponComponents(this);
+	LOG_RETURN(WeaponComponents.Num() != 0, LogAI, Warning, "Enemy %s doesn't have a weapon component", *GetName());
+	ASSERT(WeaponComponents.Num() == 1, "Enemy %s has more than one weapon component", *GetName());
+	WeaponComponent = WeaponComponents[0];
+
+	if (!WeaponInfo->SocketName.IsNone())
+	{
+		FAttachmentTransformRules AttachmentRules = FAttachmentTransformRules::SnapToTargetNotIncludingScale;
+		AttachmentRules.bWeldSimulatedBodies = true;
+		WeaponMesh->AttachToComponent(GetMesh(), AttachmentRules, WeaponInfo->SocketName);
+	}
+
+	WeaponComponent->SetWeaponMesh(WeaponMesh);
+	WeaponComponent->Init(*WeaponInfo);
+	WeaponComponent->SetWielder(this);
+}
+
+// Return to the pool instead of being destroyed if we're pooled
+void ABaseEnemy::LifeSpanExpired()
+{
+	UEnemyPoolSubsystem* EnemyPool = GetWorld() != nullptr ? GetWorld()->GetSubsystem<UEnemyPoolSubsystem>() : nullptr;
+	if (EnemyPool != nullptr && EnemyPool->ReleaseEnemy(this))
+	{
+		return;
+	}
+
+	Super::LifeSpanExpired();
+}
+
+// Called when the enemy is taken from the pool to be spawned
+void ABaseEnemy::OnAcquiredFromPool(const FTransform& Transform)
+{
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetEnemyActive(true);
+	SetTrackedAsDamageable(true);
+
+	ABaseAIController* AIController = Cast<ABaseAIController>(GetController());
+	if (AIController != nullptr)
+	{
+		AIController->ResetAI();
+		AIController->SetAIActive(true);
+	}
+}
+
+// Called when the enemy is returned to the pool, resetting and deactivating it
+void ABaseEnemy::OnReleasedToPool()
+{
+	ABaseAIController* AIController = Cast<ABaseAIController>(GetController());
+	if (AIController != nullptr)
+	{
+		AIController->SetAIActive(false);
+	}
+
+	// Stop montages first so their end callbacks don't start a cooldown after the weapon's been reset
+	UAnimInstance* AnimInstance = GetAnimInstance();
+	if (AnimInstance != nullptr)
+	{
+		AnimInstance->StopAllMontages(0.0f);
+	}
+
+	ResetCharacter();
+	if (Weapon != nullptr)
+	{
+		Weapon->ResetWeapon();
+	}
+	if (WeaponComponent != nullptr)
+	{
+		WeaponComponent->ResetWeapon();
+	}
+
+	SetEnemyActive(false);
+	SetTrackedAsDamageable(false);
+
+	// Pooled enemies don't end play, so the damage cache has to be told they're gone
+	UDamageSubsystem* DamageSubsystem = GetWorld() != nullptr ? GetWorld()->GetSubsystem<UDamageSubsystem>() : nullptr;
+	if (DamageSubsystem != nullptr)
+	{
+		DamageSubsystem->ForgetReceiver(*this);
+	}
+}
+
+// Set whether the enemy and its weapon are in the world
+void ABaseEnemy::SetEnemyActive(bool bActive)
+{
+	SetActorHiddenInGame(!bActive);
+	SetActorEnableCollision(bActive);
+	SetActorTickEnabled(bActive);
+
+	if (GetMesh() != nullptr)
+	{
+		GetMesh()->SetComponentTickEnabled(bActive);
+	}
+
+	if (GetCharacterMovement() != nullptr)
+	{
+		GetCharacterMovement()->SetComponentTickEnabled(bActive);
+	}
+
+	if (Weapon != nullptr)
+	{
+		Weapon->SetActorHiddenInGame(!bActive);
+		Weapon->SetActorTickEnabled(bActive);
+	}
+
+	// Weapon components turn their tick back on when they next attack
+	if (!bActive && WeaponComponent != nullptr)
+	{
+		WeaponComponent->SetComponentTickEnabled(false);
+	}
+}
+
+// Switch between throttled and full rate animation
+void ABaseEnemy::UpdateAnimationRate()
+{
+	USkeletalMeshComponent* SkeletalMesh = GetMesh();
+	ASSERT_RETURN(SkeletalMesh != nullptr);
+
+	// Montages only need the full rate while they can be seen. Off screen just the montage is ticked so its notifies still fire.
+	// Visibility is checked when a montage starts or ends, which is often enough for montages as short as these
+	const bool bFullRate = bAlwaysFullRateAnimation || (bMontagePlaying && SkeletalMesh->WasRecentlyRendered());
+	SkeletalMesh->bEnableUpdateRateOptimizations = !bFullRate;
+	if (bFullRate)
+	{
+		SkeletalMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	}
+	else
+	{
+		SkeletalMesh->VisibilityBasedAnimTickOption = bMontagePlaying ? EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered : EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	}
+}
+
+// Animate at the full rate while a visible montage plays so its attack notifies aren't skipped
+void ABaseEnemy::OnMontageStarted(UAnimMontage* Montage)
+{
+	bMontagePlaying = true;
+	UpdateAnimationRate();
+}
+
+// Go back to throttled animation once no montages are playing
+void ABaseEnemy::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	// Another montage may have interrupted this one
+	UAnimInstance* AnimInstance = GetAnimInstance();
+	bMontagePlaying = AnimInstance != nullptr && AnimInstance->IsAnyMontagePlaying();
+	UpdateAnimationRate();
+}
+
+// Setup how the animation update rate is throttled once the mesh creates its params
+void ABaseEnemy::OnAnimUpdateRateParamsCreated(FAnimUpdateRateParameters* Params)
+{
+	ASSERT_RETURN(Params != nullptr);
+
+	// Interpolate between the skipped frames so the throttling isn't visible
+	Params->bInterpolateSkippedFrames = true;
+	Params->BaseVisibleDistanceFactorThesholds = AnimUpdateScreenSizeThresholds;
+}
@@ -33,6 +33,21 @@ public:
 	// The enemy only saves itself once destroyed
 	bool ActorNeedsSaving_Implementation() override { return false; }
 
+	// Whether this enemy is owned by the enemy pool
+	bool IsPooled() const { return bPooled; }
+
+	// Mark this enemy as being owned by the enemy pool
+	void SetPooled() { bPooled = true; }
+
+	/**
+	 * Called when the enemy is taken from the pool to be spawned
+	 * @param Transform	Where the enemy is being spawned
+	 */
+	void OnAcquiredFromPool(const FTransform& Transform);
+
+	// Called when the enemy is returned to the pool, resetting and deactivating it
+	void OnReleasedToPool();
+
 protected:
 	// Called when the game starts or when spawned
 	void BeginPlay() override;
@@ -46,10 +61,49 @@ protected:
 	 */
 	void OnActorDied(AActor* Actor) override;
 
+	// Return to the pool instead of being destroyed if we're pooled
+	void LifeSpanExpired() override;
+
 private:
+	/**
+	 * Set whether the enemy and its weapon are in the world
+	 * @param bActive	Whether the enemy should be active
+	 */
+	void SetEnemyActive(bool bActive);
+
 	// Spawn and setup the weapon
 	void SetupWeapon();
 
+	// Setup the weapon component and mesh living on this enemy
+	void SetupWeaponComponent();
+
+	// Switch between throttled and full rate animation
+	void UpdateAnimationRate();
+
+	/**
+	 * Animate at the full rate while a visible montage plays so its attack notifies aren't skipped
+	 * @param Montage	The montage that started
+	 */
+	UFUNCTION()
+	void OnMontageStarted(class UAnimMontage* Montage);
+
+	/**
+	 * Go back to throttled animation once no montages are playing
+	 * @param Montage		The montage that ended
+	 * @param bInterrupted	Whether the montage was interrupted
+	 */
+	UFUNCTION()
+	void OnMontageEnded(class UAnimMontage* Montage, bool bInterrupted);
+
+	/**
+	 * Setup how the animation update rate is throttled once the mesh creates its params
+	 * @param Params	The mesh's update rate params
+	 */
+	void OnAnimUpdateRateParamsCreated(struct FAnimUpdateRateParameters* Params);
+
+	// Screen sizes below which the animation updates less often, each threshold skips one more frame
+	static const TArray<float> AnimUpdateScreenSizeThresholds;
+
 	// Health
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = AI, meta = (AllowPrivateAccess = "true"))
 	class USplineFollowerComponent* SplineFollower;
@@ -61,4 +115,30 @@ private:
 	// Weapon
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
 	class ABaseEnemyWeapon* Weapon;
+
+	// Whether the weapon lives on this enemy as a component instead of being spawned as a separate actor
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	bool bWeaponAsComponent = false;
+
+	// The weapon config used when the weapon is a component
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true", EditCondition = "bWeaponAsComponent"))
+	class UWeaponInfo* WeaponInfo;
+
+	// The mesh of the weapon when the weapon is a component
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	class USkeletalMeshComponent* WeaponMesh;
+
+	// The weapon component added in blueprint, used when the weapon is a component
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	class UWeaponComponent* WeaponComponent;
+
+	// Whether the animation always updates at the full rate, regardless of distance and visibility
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Animation, meta = (AllowPrivateAccess = "true"))
+	bool bAlwaysFullRateAnimation = false;
+
+	// Whether a montage is playing, attacks are driven by montage notifies
+	bool bMontagePlaying = false;
+
+	// Whether this enemy is owned by the enemy pool
+	bool bPooled = false;
 };
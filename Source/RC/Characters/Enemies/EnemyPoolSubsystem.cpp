@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "EnemyPoolSubsystem.h"
+
+#include "RC/Characters/Enemies/BaseEnemy.h"
+#include "RC/Debug/Debug.h"
+
+// Make sure there are enough inactive enemies of a class ready to be spawned
+void UEnemyPoolSubsystem::PrewarmEnemies(TSubclassOf<ABaseEnemy> EnemyClass, int32 Count)
+{
+	ASSERT_RETURN(EnemyClass != nullptr);
+
+	FEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+	const int32 NumToCreate = Count - Pool.AvailableEnemies.Num();
+	for (int32 Index = 0; Index < NumToCreate; ++Index)
+	{
+		ABaseEnemy* Enemy = CreateEnemy(EnemyClass, FTransform::Identity);
+		ASSERT_CONTINUE(Enemy != nullptr);
+
+		Enemy->OnReleasedToPool();
+		Pool.AvailableEnemies.Add(Enemy);
+	}
+}
+
+// Spawn an enemy, reusing one from the pool if there are any available
+ABaseEnemy* UEnemyPoolSubsystem::SpawnEnemy(TSubclassOf<ABaseEnemy> EnemyClass, const FTransform& Transform)
+{
+	ASSERT_RETURN_VALUE(EnemyClass != nullptr, nullptr);
+
+	FEnemyPool* Pool = Pools.Find(EnemyClass);
+	while (Pool != nullptr && Pool->AvailableEnemies.Num() != 0)
+	{
+		ABaseEnemy* Enemy = Pool->AvailableEnemies.Pop(false);
+		if (IsValid(Enemy))
+		{
+			Enemy->OnAcquiredFromPool(Transform);
+			return Enemy;
+		}
+	}
+
+	LOG_CHECK(Pool == nullptr, LogAI, Log, "Enemy pool for %s ran dry, consider prewarming more", *EnemyClass->GetName());
+	return CreateEnemy(EnemyClass, Transform);
+}
+
+// Return an enemy to the pool
+bool UEnemyPoolSubsystem::ReleaseEnemy(ABaseEnemy* Enemy)
+{
+	ASSERT_RETURN_VALUE(Enemy != nullptr, false);
+
+	// Placed enemies are left to be destroyed
+	if (!Enemy->IsPooled())
+	{
+		return false;
+	}
+
+	Enemy->OnReleasedToPool();
+	Pools.FindOrAdd(Enemy->GetClass()).AvailableEnemies.AddUnique(Enemy);
+	return true;
+}
+
+// Create a new enemy owned by the pool
+ABaseEnemy* UEnemyPoolSubsystem::CreateEnemy(TSubclassOf<ABaseEnemy> EnemyClass, const FTransform& Transform)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN_VALUE(World != nullptr, nullptr);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ABaseEnemy* Enemy = World->SpawnActor<ABaseEnemy>(EnemyClass, Transform, SpawnParams);
+	ASSERT_RETURN_VALUE(Enemy != nullptr, nullptr);
+
+	// Spawned enemies don't always get a controller automatically
+	if (Enemy->GetController() == nullptr)
+	{
+		Enemy->SpawnDefaultController();
+	}
+
+	Enemy->SetPooled();
+	return Enemy;
+}
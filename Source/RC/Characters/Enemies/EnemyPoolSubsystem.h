@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "EnemyPoolSubsystem.generated.h"
+
+/**
+ * Enemies waiting to be reused for a single class
+ */
+USTRUCT()
+struct FEnemyPool
+{
+	GENERATED_BODY()
+
+	// Enemies that are inactive and ready to be spawned
+	UPROPERTY()
+	TArray<class ABaseEnemy*> AvailableEnemies;
+};
+
+/**
+ * Keeps dead enemies around to be reused instead of destroying them and spawning new ones.
+ * Enemies are reused along with their controller and weapon
+ */
+UCLASS()
+class RC_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Make sure there are enough inactive enemies of a class ready to be spawned
+	 * @param EnemyClass	The class of enemy to create
+	 * @param Count			The number of enemies that should be available
+	 */
+	UFUNCTION(BlueprintCallable)
+	void PrewarmEnemies(TSubclassOf<class ABaseEnemy> EnemyClass, int32 Count);
+
+	/**
+	 * Spawn an enemy, reusing one from the pool if there are any available
+	 * @param EnemyClass	The class of enemy to spawn
+	 * @param Transform		Where to spawn the enemy
+	 * Returns the spawned enemy
+	 */
+	UFUNCTION(BlueprintCallable)
+	class ABaseEnemy* SpawnEnemy(TSubclassOf<class ABaseEnemy> EnemyClass, const FTransform& Transform);
+
+	/**
+	 * Return an enemy to the pool
+	 * @param Enemy	The enemy to return
+	 * Returns false if the enemy wasn't spawned by the pool
+	 */
+	bool ReleaseEnemy(class ABaseEnemy* Enemy);
+
+private:
+	// Create a new enemy owned by the pool
+	class ABaseEnemy* CreateEnemy(TSubclassOf<class ABaseEnemy> EnemyClass, const FTransform& Transform);
+
+	// Available enemies for each class
+	UPROPERTY()
+	TMap<TSubclassOf<class ABaseEnemy>, FEnemyPool> Pools;
+};
@@ -18,6 +18,7 @@
 #include "RC/Characters/Player/RCPlayerController.h"
 #include "RC/Characters/Player/RCPlayerState.h"
 #include "RC/Collectibles/Collectible.h"
+#include "RC/Framework/DamageSubsystem.h"
 #include "RC/Gameplay/MovingTeleporter.h"
 #include "RC/Util/DataSingleton.h"
 #include "RC/Util/RCStatics.h"
@@ -108,6 +109,9 @@ void ARCCharacter::Serialize(FArchive& Ar)
 // Called when the game starts or when spawned
 void ARCCharacter::BeginPlay()
 {
+	// Built before the inventory can equip anything so the weapons are ignored as they're equipped
+	AimTraceParams = FCollisionQueryParams(SCENE_QUERY_STAT(AimTrace), true, this);
+
 	Super::BeginPlay();
 
 	ASSERT_RETURN(GEngine != nullptr);
@@ -132,6 +136,11 @@ void ARCCharacter::BeginPlay()
 	{
 		OnCollectibleBeginOverlap(nullptr, OverlappingActor, nullptr, 0, false, EmptyResult);
 	}
+
+	// XP from damage is granted once the frame's damage has been resolved
+	UDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
+	DamageSubsystem->OnDamageResolved().AddUObject(this, &ARCCharacter::GrantPendingXP);
 }
 
 // Called every frame
@@ -174,13 +183,29 @@ void ARCCharacter::Tick(float DeltaTime)
 // Called when the character has given damage to someone else
 void ARCCharacter::OnDamageGiven(const FDamageReceivedParams& Params)
 {
+	// Granted once the rest of the frame's damage has been resolved
+	PendingXP.FindOrAdd(Params.CauseId) += Params.DamageDealt;
+}
+
+// Grant the XP built up from the damage given this frame, once per weapon
+void ARCCharacter::GrantPendingXP()
+{
+	if (PendingXP.Num() == 0)
+	{
+		return;
+	}
+
 	ARCPlayerState* State = GetPlayerState<ARCPlayerState>();
 	ASSERT_RETURN(State != nullptr);
 
-	UPlayerWeaponData* PlayerWeaponData = State->FindOrAddDataForAsset<UPlayerWeaponData>(Params.CauseId);
-	ASSERT_RETURN(PlayerWeaponData != nullptr, "Weapon Data not able to be added");
+	for (const TPair<FPrimaryAssetId, float>& XP : PendingXP)
+	{
+		UPlayerWeaponData* PlayerWeaponData = State->FindOrAddDataForAsset<UPlayerWeaponData>(XP.Key);
+		ASSERT_CONTINUE(PlayerWeaponData != nullptr, "Weapon Data not able to be added");
 
-	PlayerWeaponData->GrantDamageXP(Params.DamageDealt);
+		PlayerWeaponData->GrantDamageXP(XP.Value);
+	}
+	PendingXP.Reset();
 }
 
 // Get the currently equipped weapon
@@ -189,6 +214,67 @@ ABaseWeapon* ARCCharacter::GetEquippedWeapon() const
 	return Inventory != nullptr ? Inventory->GetEquippedWeapon() : nullptr;
 }
 
+// Get what the camera is aiming at
+FVector ARCCharacter::GetAimTarget(float Distance)
+{
+	UpdateAimTrace();
+
+	if (AimHit.bBlockingHit && AimHit.Distance <= Distance)
+	{
+		return AimHit.ImpactPoint;
+	}
+	return AimStart + AimDirection * Distance;
+}
+
+// Trace the camera's aim if it hasn't been yet this frame
+void ARCCharacter::UpdateAimTrace()
+{
+	if (AimTraceFrame == GFrameCounter)
+	{
+		return;
+	}
+	AimTraceFrame = GFrameCounter;
+
+	ASSERT_RETURN(FollowCamera != nullptr);
+	AimStart = FollowCamera->GetComponentLocation();
+	AimDirection = FollowCamera->GetComponentRotation().Vector();
+	AimHit = FHitResult(EForceInit::ForceInit);
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+	World->LineTraceSingleByChannel(AimHit, AimStart, AimStart + AimDirection * MaxAimDistance, ECC_Camera, AimTraceParams);
+}
+
+// Get what the camera is aiming at without tracing on the game thread
+FVector ARCCharacter::GetAsyncAimTarget(float Distance)
+{
+	ASSERT_RETURN_VALUE(FollowCamera != nullptr, FVector::ZeroVector);
+	const FVector Start = FollowCamera->GetComponentLocation();
+	const FVector Direction = FollowCamera->GetComponentRotation().Vector();
+
+	// Request the next aim trace if it hasn't been yet this frame
+	UWorld* World = GetWorld();
+	if (AsyncAimTraceFrame != GFrameCounter && World != nullptr)
+	{
+		AsyncAimTraceFrame = GFrameCounter;
+		if (!AsyncAimTraceDelegate.IsBound())
+		{
+			AsyncAimTraceDelegate.BindUObject(this, &ARCCharacter::OnAsyncAimTraceFinished);
+		}
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start + Direction * MaxAimDistance, ECC_Camera, AimTraceParams, FCollisionResponseParams::DefaultResponseParam, &AsyncAimTraceDelegate);
+	}
+
+	// The last trace is a frame behind, so only its distance is used to keep the aim on the camera's current direction
+	const float AimDistance = AsyncAimHit.bBlockingHit ? FMath::Min(AsyncAimHit.Distance, Distance) : Distance;
+	return Start + Direction * AimDistance;
+}
+
+// Called when an async aim trace has finished
+void ARCCharacter::OnAsyncAimTraceFinished(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	AsyncAimHit = Datum.OutHits.Num() > 0 ? Datum.OutHits[0] : FHitResult(EForceInit::ForceInit);
+}
+
 // Setup the player inputs
 void ARCCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
 {
@@ -458,8 +544,14 @@ void ARCCharacter::OnWeaponEquipped(ABasePlayerWeapon* Weapon, EInventorySlot Sl
 {
 	if (Weapon != nullptr)
 	{
-		// Listen for the level up
-		Weapon->OnLevelUp().AddDynamic(this, &ARCCharacter::OnWeaponLevelUp);
+		// Don't let the camera aim at our own weapon
+		if (!AimTraceParams.GetIgnoredActors().Contains(Weapon->GetUniqueID()))
+		{
+			AimTraceParams.AddIgnoredActor(Weapon);
+		}
+
+		// Listen for the level up. Weapons stay spawned between equips so they may already be listened to
+		Weapon->OnLevelUp().AddUniqueDynamic(this, &ARCCharacter::OnWeaponLevelUp);
 	}
 }
 
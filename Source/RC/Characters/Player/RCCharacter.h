@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 
+#include "WorldCollision.h"
+
 #include "RC/Characters/BaseCharacter.h"
 #include "RC/Util/RCTypes.h"
 #include "RC/Util/TimeStamp.h"
@@ -59,6 +61,21 @@ public:
 	// Get the currently equipped weapon
 	class ABaseWeapon* GetEquippedWeapon() const override;
 
+	/**
+	 * Get what the camera is aiming at. The camera is traced at most once per frame, on the first request, and shared by every weapon
+	 * @param Distance	How far from the camera to aim
+	 * Returns what was hit within the distance, otherwise the end of the aim
+	 */
+	FVector GetAimTarget(float Distance);
+
+	/**
+	 * Get what the camera is aiming at without tracing on the game thread. An async trace is requested at most once per frame and
+	 * the distance from the last one that finished is applied along the current aim
+	 * @param Distance	How far from the camera to aim
+	 * Returns what was last hit within the distance, otherwise the end of the aim
+	 */
+	FVector GetAsyncAimTarget(float Distance);
+
 	// Returns CameraBoom subobject
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	// Returns FollowCamera subobject
@@ -210,6 +227,12 @@ private:
 	// Whether the Half Attack action is being pressed
 	bool bHalfAttackHeld = false;
 
+	// Grant the XP built up from the damage given this frame, once per weapon
+	void GrantPendingXP();
+
+	// XP built up from the damage given this frame, for each weapon asset
+	TMap<FPrimaryAssetId, float> PendingXP;
+
 	// Timer to keep track of level up slowmo
 	FTimeStamp LevelUpTimer;
 
@@ -218,6 +241,40 @@ private:
 
 	// Timer to decide between swapping between weapons vs opening the weapon select
 	FTimeStamp WeaponSelectTimer;
+
+	// How far the camera aim trace reaches
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	float MaxAimDistance = 20000.0f;
+
+	// Trace the camera's aim if it hasn't been yet this frame
+	void UpdateAimTrace();
+
+	// Query params for the aim trace, built once
+	FCollisionQueryParams AimTraceParams;
+
+	// Result of this frame's aim trace
+	FHitResult AimHit;
+
+	// Where the aim trace started from
+	FVector AimStart = FVector::ZeroVector;
+
+	// Direction of the aim trace
+	FVector AimDirection = FVector::ForwardVector;
+
+	// The frame the aim was last traced on
+	uint64 AimTraceFrame = 0;
+
+	// Called when an async aim trace has finished
+	void OnAsyncAimTraceFinished(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	// Delegate for the async aim traces
+	FTraceDelegate AsyncAimTraceDelegate;
+
+	// Result of the last async aim trace that finished
+	FHitResult AsyncAimHit;
+
+	// The frame the last async aim trace was requested on
+	uint64 AsyncAimTraceFrame = 0;
 };
 
 /**
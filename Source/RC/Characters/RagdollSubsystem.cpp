@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "RagdollSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+
+#include "RC/Characters/BaseCharacter.h"
+#include "RC/Debug/Debug.h"
+
+const int32 URagdollSubsystem::MaxSimulatedRagdolls = 8;
+const int32 URagdollSubsystem::MaxCorpses = 20;
+const float URagdollSubsystem::SettleSpeed = 10.0f;
+const float URagdollSubsystem::SettleTime = 0.5f;
+const float URagdollSubsystem::MaxSimulationTime = 3.0f;
+
+// Freeze settled ragdolls and clean up extra bodies
+void URagdollSubsystem::Tick(float DeltaTime)
+{
+	for (int32 Index = Corpses.Num() - 1; Index >= 0; --Index)
+	{
+		FCorpse& Corpse = Corpses[Index];
+		ABaseCharacter* Character = Corpse.Character.Get();
+		if (Character == nullptr)
+		{
+			NumSimulating -= Corpse.bSimulating ? 1 : 0;
+			Corpses.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (!Corpse.bSimulating)
+		{
+			continue;
+		}
+
+		Corpse.SimulationTime += DeltaTime;
+		const USkeletalMeshComponent* SkeletalMesh = Character->GetMesh();
+		if (SkeletalMesh != nullptr && SkeletalMesh->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(SettleSpeed))
+		{
+			Corpse.SettledTime += DeltaTime;
+		}
+		else
+		{
+			Corpse.SettledTime = 0.0f;
+		}
+
+		if (Corpse.SettledTime >= SettleTime || Corpse.SimulationTime >= MaxSimulationTime)
+		{
+			FreezeCorpse(Corpse);
+		}
+	}
+
+	// Too many bodies, clean up the ones the player is least likely to notice
+	while (Corpses.Num() > MaxCorpses)
+	{
+		const int32 FurthestIndex = FindFurthestCorpse(false);
+		ASSERT_RETURN(FurthestIndex != INDEX_NONE);
+
+		FCorpse Corpse = Corpses[FurthestIndex];
+		NumSimulating -= Corpse.bSimulating ? 1 : 0;
+		Corpses.RemoveAtSwap(FurthestIndex);
+
+		// The character may be reused straight away so it's removed first
+		ABaseCharacter* Character = Corpse.Character.Get();
+		if (Character != nullptr)
+		{
+			Character->ReleaseCorpse();
+		}
+	}
+}
+
+// Add a dead character and ask whether it's allowed to ragdoll
+bool URagdollSubsystem::RequestRagdoll(ABaseCharacter& Character)
+{
+	FCorpse* Corpse = Corpses.FindByPredicate([&Character](const FCorpse& Other) { return Other.Character == &Character; });
+	if (Corpse == nullptr)
+	{
+		Corpse = &Corpses.AddDefaulted_GetRef();
+		Corpse->Character = &Character;
+	}
+	else if (Corpse->bSimulating)
+	{
+		return true;
+	}
+
+	if (NumSimulating >= MaxSimulatedRagdolls)
+	{
+		// Make room if there's a ragdoll further away than this one
+		const int32 FurthestIndex = FindFurthestCorpse(true);
+		if (FurthestIndex == INDEX_NONE || GetDistanceSquaredToPlayer(*Corpses[FurthestIndex].Character) <= GetDistanceSquaredToPlayer(Character))
+		{
+			return false;
+		}
+
+		FreezeCorpse(Corpses[FurthestIndex]);
+	}
+
+	Corpse->bSimulating = true;
+	Corpse->SimulationTime = 0.0f;
+	Corpse->SettledTime = 0.0f;
+	++NumSimulating;
+	return true;
+}
+
+// Remove a character that's no longer dead
+void URagdollSubsystem::RemoveCorpse(const ABaseCharacter& Character)
+{
+	const int32 Index = Corpses.IndexOfByPredicate([&Character](const FCorpse& Corpse) { return Corpse.Character == &Character; });
+	if (Index != INDEX_NONE)
+	{
+		NumSimulating -= Corpses[Index].bSimulating ? 1 : 0;
+		Corpses.RemoveAtSwap(Index);
+	}
+}
+
+// Find the corpse furthest from the player
+int32 URagdollSubsystem::FindFurthestCorpse(bool bSimulatingOnly) const
+{
+	int32 FurthestIndex = INDEX_NONE;
+	float FurthestDistanceSqr = -1.0f;
+	for (int32 Index = 0; Index < Corpses.Num(); ++Index)
+	{
+		const FCorpse& Corpse = Corpses[Index];
+		const ABaseCharacter* Character = Corpse.Character.Get();
+		if (Character == nullptr || (bSimulatingOnly && !Corpse.bSimulating))
+		{
+			continue;
+		}
+
+		const float DistanceSqr = GetDistanceSquaredToPlayer(*Character);
+		if (DistanceSqr > FurthestDistanceSqr)
+		{
+			FurthestDistanceSqr = DistanceSqr;
+			FurthestIndex = Index;
+		}
+	}
+	return FurthestIndex;
+}
+
+// Get the squared distance of a character from the player
+float URagdollSubsystem::GetDistanceSquaredToPlayer(const ABaseCharacter& Character) const
+{
+	const APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	if (Player == nullptr)
+	{
+		return 0.0f;
+	}
+
+	// The body is wherever the mesh has fallen to, not the capsule
+	const USkeletalMeshComponent* SkeletalMesh = Character.GetMesh();
+	const FVector Location = SkeletalMesh != nullptr ? SkeletalMesh->GetComponentLocation() : Character.GetActorLocation();
+	return FVector::DistSquared(Player->GetActorLocation(), Location);
+}
+
+// Stop a ragdoll simulating, keeping its pose
+void URagdollSubsystem::FreezeCorpse(FCorpse& Corpse)
+{
+	if (!Corpse.bSimulating)
+	{
+		return;
+	}
+
+	Corpse.bSimulating = false;
+	--NumSimulating;
+
+	ABaseCharacter* Character = Corpse.Character.Get();
+	if (Character != nullptr)
+	{
+		Character->FreezeRagdoll();
+	}
+}
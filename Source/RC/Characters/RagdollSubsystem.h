@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RagdollSubsystem.generated.h"
+
+/**
+ * Caps how many dead characters simulate their ragdoll at once.
+ * Settled ragdolls are frozen in their pose, characters dying over budget fall back to their death montage
+ * and once there are too many bodies the ones furthest from the player are cleaned up early
+ */
+UCLASS()
+class RC_API URagdollSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// FTickableGameObject implementation Begin
+	// Whether this subsystem should tick
+	virtual bool IsTickable() const override { return Corpses.Num() != 0 && Super::IsTickable(); }
+
+	// Freeze settled ragdolls and clean up extra bodies
+	virtual void Tick(float DeltaTime) override;
+
+	// Needed for tickables
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(URagdollSubsystem, STATGROUP_Tickables); }
+	// FTickableGameObject implementation End
+
+	/**
+	 * Add a dead character and ask whether it's allowed to ragdoll.
+	 * If the budget is full the ragdoll furthest from the player is frozen to make room, as long as it's further than the new one
+	 *
+	 * @param Character	The character that died
+	 * Returns true if the character should ragdoll
+	 */
+	bool RequestRagdoll(class ABaseCharacter& Character);
+
+	/**
+	 * Remove a character that's no longer dead
+	 * @param Character	The character to remove
+	 */
+	void RemoveCorpse(const class ABaseCharacter& Character);
+
+private:
+	/**
+	 * A dead character being tracked
+	 */
+	struct FCorpse
+	{
+		// The dead character
+		TWeakObjectPtr<class ABaseCharacter> Character;
+
+		// How long the ragdoll has been simulating
+		float SimulationTime = 0.0f;
+
+		// How long the ragdoll has been moving slow enough to be settled
+		float SettledTime = 0.0f;
+
+		// Whether the ragdoll is simulating
+		bool bSimulating = false;
+	};
+
+	/**
+	 * Find the corpse furthest from the player
+	 * @param bSimulatingOnly	Whether to only consider simulating ragdolls
+	 * Returns the index of the corpse, INDEX_NONE if there isn't one
+	 */
+	int32 FindFurthestCorpse(bool bSimulatingOnly) const;
+
+	// Get the squared distance of a character from the player
+	float GetDistanceSquaredToPlayer(const class ABaseCharacter& Character) const;
+
+	// Stop a ragdoll simulating, keeping its pose
+	void FreezeCorpse(FCorpse& Corpse);
+
+	// Max number of ragdolls simulating at once
+	static const int32 MaxSimulatedRagdolls;
+
+	// Max number of bodies before the furthest are cleaned up early
+	static const int32 MaxCorpses;
+
+	// Speed in cm/s below which a ragdoll is considered still
+	static const float SettleSpeed;
+
+	// How long a ragdoll needs to be still before it's frozen
+	static const float SettleTime;
+
+	// Longest a ragdoll can simulate before it's frozen regardless
+	static const float MaxSimulationTime;
+
+	// Every dead character being tracked
+	TArray<FCorpse> Corpses;
+
+	// Number of corpses that are simulating
+	int32 NumSimulating = 0;
+};
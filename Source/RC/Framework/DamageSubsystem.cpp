@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "DamageSubsystem.h"
+
+#include "RC/Characters/Components/StatusEffectComponent.h"
+#include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageInterface.h"
+
+// Resolve the damage queued this frame
+void UDamageSubsystem::Tick(float DeltaTime)
+{
+	// Combine hits on the same receiver from the same source so it's only damaged once
+	ResolvingDamage.Reset();
+	for (const FQueuedDamage& Damage : QueuedDamage)
+	{
+		FQueuedDamage* Combined = ResolvingDamage.FindByPredicate([&Damage](const FQueuedDamage& Other)
+		{
+			return Other.Receiver == Damage.Receiver
+				&& Other.Params.Instigator == Damage.Params.Instigator
+				&& Other.Params.CauseId == Damage.Params.CauseId
+				&& Other.Params.DamageType == Damage.Params.DamageType
+				&& Other.Params.bFromPlayer == Damage.Params.bFromPlayer;
+		});
+
+		if (Combined != nullptr)
+		{
+			// Keep the latest hit's location
+			Combined->Params.Damage += Damage.Params.Damage;
+			Combined->Params.HitLocation = Damage.Params.HitLocation;
+			Combined->Params.HitNormal = Damage.Params.HitNormal;
+		}
+		else
+		{
+			ResolvingDamage.Add(Damage);
+		}
+	}
+	QueuedDamage.Reset();
+	Swap(ResolvingStatusEffects, QueuedStatusEffects);
+
+	// Anything queued while resolving is resolved next frame
+	for (FQueuedDamage& Damage : ResolvingDamage)
+	{
+		AActor* Receiver = Damage.Receiver.Get();
+		if (Receiver == nullptr)
+		{
+			continue;
+		}
+
+		IDamageInterface* Damageable = FindOrAddReceiver(*Receiver).Damageable;
+		if (Damageable != nullptr)
+		{
+			Damageable->RequestDamage(Damage.Params);
+		}
+	}
+
+	for (const FQueuedStatusEffect& StatusEffect : ResolvingStatusEffects)
+	{
+		AActor* Receiver = StatusEffect.Receiver.Get();
+		if (Receiver == nullptr)
+		{
+			continue;
+		}
+
+		UStatusEffectComponent* StatusEffectComponent = FindOrAddReceiver(*Receiver).StatusEffects.Get();
+		if (StatusEffectComponent != nullptr)
+		{
+			FStatusEffectTimedRequest TimedRequest(StatusEffect.StatusEffectClass, StatusEffect.Duration);
+			StatusEffectComponent->AddStatusEffectTimed(TimedRequest);
+		}
+	}
+	ResolvingStatusEffects.Reset();
+
+	DamageResolvedDelegate.Broadcast();
+}
+
+// Queue damage on an actor to be resolved at the end of the frame
+bool UDamageSubsystem::QueueDamage(AActor& Receiver, const FDamageRequestParams& Params, TSubclassOf<UBaseStatusEffect> TimedStatusEffectClass/* = NULL*/, float TimedStatusEffectDuration/* = 0.0f*/)
+{
+	const FDamageReceiver& DamageReceiver = FindOrAddReceiver(Receiver);
+
+	// Status effects are given even to actors that can't be damaged
+	if (TimedStatusEffectClass != NULL && DamageReceiver.StatusEffects.IsValid())
+	{
+		FQueuedStatusEffect& StatusEffect = QueuedStatusEffects.AddDefaulted_GetRef();
+		StatusEffect.Receiver = &Receiver;
+		StatusEffect.StatusEffectClass = TimedStatusEffectClass;
+		StatusEffect.Duration = TimedStatusEffectDuration;
+	}
+
+	if (DamageReceiver.Damageable == nullptr)
+	{
+		return false;
+	}
+
+	FQueuedDamage& Damage = QueuedDamage.AddDefaulted_GetRef();
+	Damage.Receiver = &Receiver;
+	Damage.Params = Params;
+	return true;
+}
+
+// Whether an actor can be damaged
+bool UDamageSubsystem::IsDamageable(AActor& Actor)
+{
+	return FindOrAddReceiver(Actor).Damageable != nullptr;
+}
+
+// Forget the cached receiver of an actor
+void UDamageSubsystem::ForgetReceiver(AActor& Actor)
+{
+	if (Receivers.Remove(&Actor) != 0)
+	{
+		Actor.OnEndPlay.RemoveDynamic(this, &UDamageSubsystem::OnReceiverEndPlay);
+	}
+}
+
+// Get the cached ways an actor can be damaged
+const UDamageSubsystem::FDamageReceiver& UDamageSubsystem::FindOrAddReceiver(AActor& Actor)
+{
+	FDamageReceiver* Receiver = Receivers.Find(&Actor);
+	if (Receiver != nullptr)
+	{
+		return *Receiver;
+	}
+
+	Receiver = &Receivers.Add(&Actor);
+	Receiver->Damageable = Cast<IDamageInterface>(&Actor);
+	Receiver->StatusEffects = Actor.FindComponentByClass<UStatusEffectComponent>();
+
+	// Streamed out actors end play without being destroyed, so they're forgotten then too
+	Actor.OnEndPlay.AddDynamic(this, &UDamageSubsystem::OnReceiverEndPlay);
+	return *Receiver;
+}
+
+// Forget the cached receiver of an actor leaving the world
+void UDamageSubsystem::OnReceiverEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	ASSERT_RETURN(Actor != nullptr);
+	ForgetReceiver(*Actor);
+}
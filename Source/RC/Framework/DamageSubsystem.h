@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RC/Weapons/RCWeaponTypes.h"
+
+#include "DamageSubsystem.generated.h"
+
+// Executed once the damage queued during the frame has been resolved
+DECLARE_MULTICAST_DELEGATE(FOnDamageResolved);
+
+/**
+ * Queues the damage dealt during the frame and resolves it in a single pass at the end of it.
+ * Hits on the same receiver from the same instigator and cause are combined into one request, so health broadcasts and XP grants happen once per receiver
+ */
+UCLASS()
+class RC_API UDamageSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// FTickableGameObject implementation Begin
+	// Whether this subsystem should tick
+	virtual bool IsTickable() const override { return QueuedDamage.Num() != 0 && Super::IsTickable(); }
+
+	// Resolve the damage queued this frame
+	virtual void Tick(float DeltaTime) override;
+
+	// Needed for tickables
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UDamageSubsystem, STATGROUP_Tickables); }
+	// FTickableGameObject implementation End
+
+	/**
+	 * Queue damage on an actor to be resolved at the end of the frame
+	 *
+	 * @param Receiver						The actor to damage
+	 * @param Params						The request params
+	 * @param TimedStatusEffectClass		Status effect to give the actor, if any
+	 * @param TimedStatusEffectDuration		Time in seconds the status effect is applied for
+	 * Returns false if the actor can't be damaged. The status effect is still given if the actor has a status effect component
+	 */
+	bool QueueDamage(AActor& Receiver, const FDamageRequestParams& Params, TSubclassOf<class UBaseStatusEffect> TimedStatusEffectClass = NULL, float TimedStatusEffectDuration = 0.0f);
+
+	/**
+	 * Whether an actor can be damaged
+	 * @param Actor	The actor to test
+	 */
+	bool IsDamageable(AActor& Actor);
+
+	/**
+	 * Forget the cached receiver of an actor, for actors leaving the world without ending play such as ones returned to a pool
+	 * @param Actor	The actor to forget
+	 */
+	void ForgetReceiver(AActor& Actor);
+
+	// Get the delegate executed once the damage queued during the frame has been resolved
+	FOnDamageResolved& OnDamageResolved() { return DamageResolvedDelegate; }
+
+private:
+	/**
+	 * Damage waiting to be resolved
+	 */
+	struct FQueuedDamage
+	{
+		// Actor to damage
+		TWeakObjectPtr<AActor> Receiver;
+
+		// The request params
+		FDamageRequestParams Params;
+	};
+
+	/**
+	 * A status effect waiting to be given
+	 */
+	struct FQueuedStatusEffect
+	{
+		// Actor to give the status effect
+		TWeakObjectPtr<AActor> Receiver;
+
+		// The status effect to give
+		TSubclassOf<class UBaseStatusEffect> StatusEffectClass;
+
+		// Time in seconds the status effect is applied for
+		float Duration = 0.0f;
+	};
+
+	/**
+	 * The cached ways an actor can be damaged
+	 */
+	struct FDamageReceiver
+	{
+		// The actor's damage interface, null if it can't be damaged
+		class IDamageInterface* Damageable = nullptr;
+
+		// The actor's status effect component
+		TWeakObjectPtr<class UStatusEffectComponent> StatusEffects;
+	};
+
+	/**
+	 * Get the cached ways an actor can be damaged, caching them if this is the first time it's been asked for
+	 * @param Actor	The actor to get the receiver for
+	 * Returns the receiver
+	 */
+	const FDamageReceiver& FindOrAddReceiver(AActor& Actor);
+
+	/**
+	 * Forget the cached receiver of an actor leaving the world
+	 * @param Actor			The actor that ended play
+	 * @param EndPlayReason	Why the actor ended play
+	 */
+	UFUNCTION()
+	void OnReceiverEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	// Cached receivers of every actor damage has been queued on
+	TMap<TWeakObjectPtr<AActor>, FDamageReceiver> Receivers;
+
+	// Damage queued this frame
+	TArray<FQueuedDamage> QueuedDamage;
+
+	// Status effects queued this frame
+	TArray<FQueuedStatusEffect> QueuedStatusEffects;
+
+	// The queued damage combined per receiver, kept around to avoid reallocating
+	TArray<FQueuedDamage> ResolvingDamage;
+
+	// The queued status effects being given, kept around to avoid reallocating
+	TArray<FQueuedStatusEffect> ResolvingStatusEffects;
+
+	// Executed once the damage queued during the frame has been resolved
+	FOnDamageResolved DamageResolvedDelegate;
+};
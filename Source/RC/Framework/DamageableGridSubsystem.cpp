@@ -0,0 +1,261 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "DamageableGridSubsystem.h"
+
+#include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageInterface.h"
+
+const float UDamageableGridSubsystem::CellSize = 1000.0f;
+
+// Start tracking a damageable actor
+void UDamageableGridSubsystem::RegisterDamageable(AActor& Actor)
+{
+	ASSERT_RETURN(Cast<IDamageInterface>(&Actor) != nullptr, "%s is registered as damageable but doesn't implement IDamageInterface", *Actor.GetName());
+
+	USceneComponent* Root = Actor.GetRootComponent();
+	ASSERT_RETURN(Root != nullptr);
+
+	if (Entries.Contains(&Actor))
+	{
+		return;
+	}
+
+	FDamageableEntry& Entry = Entries.Add(&Actor);
+	Entry.Location = Root->GetComponentLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	Entry.MovedHandle = Root->TransformUpdated.AddUObject(this, &UDamageableGridSubsystem::OnDamageableMoved);
+
+	Cells.FindOrAdd(Entry.Cell).Add(&Actor);
+}
+
+// Stop tracking a damageable actor
+void UDamageableGridSubsystem::UnregisterDamageable(AActor& Actor)
+{
+	FDamageableEntry Entry;
+	if (!Entries.RemoveAndCopyValue(&Actor, Entry))
+	{
+		return;
+	}
+
+	USceneComponent* Root = Actor.GetRootComponent();
+	if (Root != nullptr)
+	{
+		Root->TransformUpdated.Remove(Entry.MovedHandle);
+	}
+
+	TArray<AActor*>* Cell = Cells.Find(Entry.Cell);
+	ASSERT_RETURN(Cell != nullptr);
+	Cell->RemoveSwap(&Actor);
+	if (Cell->Num() == 0)
+	{
+		Cells.Remove(Entry.Cell);
+	}
+}
+
+// Find the damageable actors within a radius
+void UDamageableGridSubsystem::FindInRadius(const FVector& Origin, float Radius, TArray<AActor*>& OutActors, const FDamageableFilter& Filter/* = nullptr*/) const
+{
+	OutActors.Reset();
+
+	const float RadiusSqr = FMath::Square(Radius);
+	ForEachInRadius(Origin, Radius, [&](AActor& Actor, const FDamageableEntry& Entry)
+	{
+		if (FVector::DistSquared(Origin, Entry.Location) <= RadiusSqr && (!Filter || Filter(Actor)))
+		{
+			OutActors.Add(&Actor);
+		}
+	});
+}
+
+// Find the nearest damageable actors within a radius
+void UDamageableGridSubsystem::FindNearest(const FVector& Origin, int32 Count, float Radius, TArray<AActor*>& OutActors, const FDamageableFilter& Filter/* = nullptr*/) const
+{
+	OutActors.Reset();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	const float RadiusSqr = FMath::Square(Radius);
+	TArray<TPair<float, AActor*>, TInlineAllocator<16>> Candidates;
+	auto AddCandidate = [&](AActor& Actor, const FDamageableEntry& Entry)
+	{
+		const float DistanceSqr = FVector::DistSquared(Origin, Entry.Location);
+		if (DistanceSqr <= RadiusSqr && (!Filter || Filter(Actor)))
+		{
+			Candidates.Emplace(DistanceSqr, &Actor);
+		}
+	};
+	auto SortCandidates = [&Candidates]()
+	{
+		Candidates.Sort([](const TPair<float, AActor*>& A, const TPair<float, AActor*>& B) { return A.Key < B.Key; });
+	};
+
+	const int32 MaxRing = FMath::CeilToInt(Radius / CellSize);
+	if (FMath::Square(2 * MaxRing + 1) > Cells.Num())
+	{
+		// There are fewer occupied cells than cells in range, so just check them all
+		ForEachInRadius(Origin, Radius, AddCandidate);
+		SortCandidates();
+	}
+	else
+	{
+		// Search outwards a ring of cells at a time until nothing further out could be closer than what's been found
+		const FIntPoint Center = GetCell(Origin);
+		auto VisitCell = [&](const FIntPoint& CellIndex)
+		{
+			const TArray<AActor*>* Cell = Cells.Find(CellIndex);
+			if (Cell != nullptr)
+			{
+				for (AActor* Actor : *Cell)
+				{
+					AddCandidate(*Actor, Entries.FindChecked(Actor));
+				}
+			}
+		};
+
+		for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+		{
+			if (Ring > 0 && Candidates.Num() >= Count)
+			{
+				// The origin can be anywhere in the center cell, so a ring is at least one ring less of cells away
+				SortCandidates();
+				if (Candidates[Count - 1].Key <= FMath::Square((Ring - 1) * CellSize))
+				{
+					break;
+				}
+			}
+
+			for (int32 X = -Ring; X <= Ring; ++X)
+			{
+				// Only the edge of the ring, the inside has already been visited
+				const int32 YStep = FMath::Abs(X) == Ring ? 1 : FMath::Max(2 * Ring, 1);
+				for (int32 Y = -Ring; Y <= Ring; Y += YStep)
+				{
+					VisitCell(Center + FIntPoint(X, Y));
+				}
+			}
+		}
+		SortCandidates();
+	}
+
+	const int32 NumFound = FMath::Min(Count, Candidates.Num());
+	OutActors.Reserve(NumFound);
+	for (int32 CandidateIndex = 0; CandidateIndex < NumFound; ++CandidateIndex)
+	{
+		OutActors.Add(Candidates[CandidateIndex].Value);
+	}
+}
+
+// Find the damageable actors within a cone
+void UDamageableGridSubsystem::FindInCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, TArray<AActor*>& OutActors, const FDamageableFilter& Filter/* = nullptr*/) const
+{
+	OutActors.Reset();
+
+	const FVector ConeDirection = Direction.GetSafeNormal();
+	const float MinCos = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+	const float RangeSqr = FMath::Square(Range);
+	ForEachInRadius(Origin, Range, [&](AActor& Actor, const FDamageableEntry& Entry)
+	{
+		const FVector ToActor = Entry.Location - Origin;
+		const float DistanceSqr = ToActor.SizeSquared();
+		if (DistanceSqr > RangeSqr)
+		{
+			return;
+		}
+
+		// Anything right at the tip is inside
+		if (DistanceSqr > SMALL_NUMBER && FVector::DotProduct(ToActor, ConeDirection) < MinCos * FMath::Sqrt(DistanceSqr))
+		{
+			return;
+		}
+
+		if (!Filter || Filter(Actor))
+		{
+			OutActors.Add(&Actor);
+		}
+	});
+}
+
+// Called when a tracked actor's root component has moved
+void UDamageableGridSubsystem::OnDamageableMoved(USceneComponent* Component, EUpdateTransformFlags, ETeleportType)
+{
+	ASSERT_RETURN(Component != nullptr);
+
+	AActor* Actor = Component->GetOwner();
+	FDamageableEntry* Entry = Entries.Find(Actor);
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	Entry->Location = Component->GetComponentLocation();
+
+	// Only move between cells when it's left its old one
+	const FIntPoint NewCell = GetCell(Entry->Location);
+	if (NewCell == Entry->Cell)
+	{
+		return;
+	}
+
+	TArray<AActor*>* OldCell = Cells.Find(Entry->Cell);
+	if (OldCell != nullptr)
+	{
+		OldCell->RemoveSwap(Actor);
+		if (OldCell->Num() == 0)
+		{
+			Cells.Remove(Entry->Cell);
+		}
+	}
+
+	Entry->Cell = NewCell;
+	Cells.FindOrAdd(NewCell).Add(Actor);
+}
+
+// Get the cell a location is in
+FIntPoint UDamageableGridSubsystem::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+// Call a function on every tracked actor in the cells overlapping a radius
+void UDamageableGridSubsystem::ForEachInRadius(const FVector& Origin, float Radius, TFunctionRef<void(AActor& Actor, const FDamageableEntry& Entry)> Visitor) const
+{
+	const FIntPoint MinCell = GetCell(Origin - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(Radius));
+
+	// Walk whichever is smaller, the occupied cells or the cells covering the radius
+	const int64 NumCellsInRange = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+	if (NumCellsInRange > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<AActor*>>& Cell : Cells)
+		{
+			if (Cell.Key.X < MinCell.X || Cell.Key.X > MaxCell.X || Cell.Key.Y < MinCell.Y || Cell.Key.Y > MaxCell.Y)
+			{
+				continue;
+			}
+
+			for (AActor* Actor : Cell.Value)
+			{
+				Visitor(*Actor, Entries.FindChecked(Actor));
+			}
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<AActor*>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+
+			for (AActor* Actor : *Cell)
+			{
+				Visitor(*Actor, Entries.FindChecked(Actor));
+			}
+		}
+	}
+}
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "DamageableGridSubsystem.generated.h"
+
+/**
+ * Keeps every damageable actor in a grid so weapons can find targets near a location without going through the physics scene.
+ * Actors register themselves when they begin play and are moved between cells as their root component moves
+ */
+UCLASS()
+class RC_API UDamageableGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Decides whether a damageable actor should be included in a query
+	typedef TFunction<bool(AActor& Actor)> FDamageableFilter;
+
+	/**
+	 * Start tracking a damageable actor
+	 * @param Actor	The actor to track, must implement IDamageInterface
+	 */
+	void RegisterDamageable(AActor& Actor);
+
+	/**
+	 * Stop tracking a damageable actor
+	 * @param Actor	The actor to stop tracking
+	 */
+	void UnregisterDamageable(AActor& Actor);
+
+	/**
+	 * Find the damageable actors within a radius
+	 *
+	 * @param Origin		The center of the search
+	 * @param Radius		How far from the origin to search
+	 * @param OutActors		The actors found, in no particular order
+	 * @param Filter		Returns whether an actor should be included, everything is included if not set
+	 */
+	void FindInRadius(const FVector& Origin, float Radius, TArray<AActor*>& OutActors, const FDamageableFilter& Filter = nullptr) const;
+
+	/**
+	 * Find the nearest damageable actors within a radius
+	 *
+	 * @param Origin		The center of the search
+	 * @param Count			The most actors to find
+	 * @param Radius		How far from the origin to search
+	 * @param OutActors		The actors found, nearest first
+	 * @param Filter		Returns whether an actor should be included, everything is included if not set
+	 */
+	void FindNearest(const FVector& Origin, int32 Count, float Radius, TArray<AActor*>& OutActors, const FDamageableFilter& Filter = nullptr) const;
+
+	/**
+	 * Find the damageable actors within a cone
+	 *
+	 * @param Origin			The tip of the cone
+	 * @param Direction			The direction the cone points
+	 * @param HalfAngleDegrees	Angle between the direction and the edge of the cone
+	 * @param Range				How far from the origin to search
+	 * @param OutActors			The actors found, in no particular order
+	 * @param Filter			Returns whether an actor should be included, everything is included if not set
+	 */
+	void FindInCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, TArray<AActor*>& OutActors, const FDamageableFilter& Filter = nullptr) const;
+
+private:
+	/**
+	 * A tracked damageable actor
+	 */
+	struct FDamageableEntry
+	{
+		// The cell the actor is in
+		FIntPoint Cell = FIntPoint::ZeroValue;
+
+		// Where the actor was when it last moved
+		FVector Location = FVector::ZeroVector;
+
+		// Handle to the root component's transform updated delegate
+		FDelegateHandle MovedHandle;
+	};
+
+	/**
+	 * Called when a tracked actor's root component has moved
+	 * @param Component	The root component that moved
+	 */
+	void OnDamageableMoved(USceneComponent* Component, EUpdateTransformFlags, ETeleportType);
+
+	/**
+	 * Get the cell a location is in
+	 * @param Location	The location to get the cell of
+	 */
+	static FIntPoint GetCell(const FVector& Location);
+
+	/**
+	 * Call a function on every tracked actor in the cells overlapping a radius
+	 *
+	 * @param Origin	The center of the area
+	 * @param Radius	How far from the origin the cells should cover
+	 * @param Visitor	Called with each actor and its entry
+	 */
+	void ForEachInRadius(const FVector& Origin, float Radius, TFunctionRef<void(AActor& Actor, const FDamageableEntry& Entry)> Visitor) const;
+
+	// Size of each cell of the grid
+	static const float CellSize;
+
+	// Every tracked actor
+	TMap<AActor*, FDamageableEntry> Entries;
+
+	// The actors in each cell, cells without actors are removed
+	TMap<FIntPoint, TArray<AActor*>> Cells;
+};
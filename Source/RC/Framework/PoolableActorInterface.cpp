@@ -0,0 +1,6 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PoolableActorInterface.h"
+
+// Add default functionality here for any IPoolableActorInterface functions that are not pure virtual.
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PoolableActorInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI)
+class UPoolableActorInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Interface for actors that the actor pool can reuse instead of destroying and spawning again
+ */
+class RC_API IPoolableActorInterface
+{
+	GENERATED_BODY()
+
+	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
+public:
+	// Called when the actor is taken from the pool, once it's been moved and shown. Anything that would be setup in BeginPlay should be setup here
+	UFUNCTION(BlueprintNativeEvent)
+	void OnAcquired();
+
+	// Called when the actor is taken from the pool
+	virtual void OnAcquired_Implementation() {}
+
+	// Called when the actor is returned to the pool or first created by it, before it's hidden
+	UFUNCTION(BlueprintNativeEvent)
+	void OnReleased();
+
+	// Called when the actor is returned to the pool
+	virtual void OnReleased_Implementation() {}
+};
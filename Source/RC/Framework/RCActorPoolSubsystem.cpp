@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "RCActorPoolSubsystem.h"
+
+#include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageSubsystem.h"
+#include "RC/Framework/PoolableActorInterface.h"
+
+// Make sure there are enough inactive actors of a class ready to be acquired
+void URCActorPoolSubsystem::PrewarmActors(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+	ASSERT_RETURN(ActorClass != nullptr);
+	ASSERT_RETURN(ActorClass->ImplementsInterface(UPoolableActorInterface::StaticClass()), "Actor class %s can't be pooled, it needs to implement IPoolableActorInterface", *ActorClass->GetName());
+
+	FRCActorPool& Pool = Pools.FindOrAdd(ActorClass);
+	const int32 NumToCreate = Count - Pool.AvailableActors.Num();
+	for (int32 Index = 0; Index < NumToCreate; ++Index)
+	{
+		AActor* Actor = CreateActor(ActorClass);
+		ASSERT_CONTINUE(Actor != nullptr);
+
+		Pool.AvailableActors.Add(Actor);
+	}
+}
+
+// Spawn an actor, reusing one from the pool if the class is poolable
+AActor* URCActorPoolSubsystem::AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner/* = nullptr*/, APawn* Instigator/* = nullptr*/)
+{
+	ASSERT_RETURN_VALUE(ActorClass != nullptr, nullptr);
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN_VALUE(World != nullptr, nullptr);
+
+	// Not poolable, spawn it like normal
+	if (!ActorClass->ImplementsInterface(UPoolableActorInterface::StaticClass()))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = Owner;
+		SpawnParams.Instigator = Instigator;
+		SpawnParams.bNoFail = true;
+		return World->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+	}
+
+	AActor* Actor = nullptr;
+	FRCActorPool& Pool = Pools.FindOrAdd(ActorClass);
+	while (Actor == nullptr && Pool.AvailableActors.Num() != 0)
+	{
+		Actor = Pool.AvailableActors.Pop(false);
+		Actor = IsValid(Actor) ? Actor : nullptr;
+	}
+
+	if (Actor == nullptr)
+	{
+		Actor = CreateActor(ActorClass);
+		ASSERT_RETURN_VALUE(Actor != nullptr, nullptr);
+	}
+
+	Actor->SetOwner(Owner);
+	Actor->SetInstigator(Instigator);
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorActive(*Actor, true);
+	IPoolableActorInterface::Execute_OnAcquired(Actor);
+	return Actor;
+}
+
+// Return an actor to the pool
+bool URCActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	ASSERT_RETURN_VALUE(Actor != nullptr, false);
+
+	if (!PooledActors.Contains(Actor))
+	{
+		return false;
+	}
+
+	FRCActorPool& Pool = Pools.FindOrAdd(Actor->GetClass());
+	if (Pool.AvailableActors.Contains(Actor))
+	{
+		return true;
+	}
+
+	IPoolableActorInterface::Execute_OnReleased(Actor);
+	SetActorActive(*Actor, false);
+	Pool.AvailableActors.Add(Actor);
+
+	// Pooled actors don't end play, so the damage cache has to be told they're gone
+	UDamageSubsystem* DamageSubsystem = GetWorld() != nullptr ? GetWorld()->GetSubsystem<UDamageSubsystem>() : nullptr;
+	if (DamageSubsystem != nullptr)
+	{
+		DamageSubsystem->ForgetReceiver(*Actor);
+	}
+	return true;
+}
+
+// Return an actor to the pool if it's owned by it, otherwise destroy it
+void URCActorPoolSubsystem::ReleaseOrDestroyActor(AActor& Actor)
+{
+	UWorld* World = Actor.GetWorld();
+	URCActorPoolSubsystem* ActorPool = World != nullptr ? World->GetSubsystem<URCActorPoolSubsystem>() : nullptr;
+	if (ActorPool == nullptr || !ActorPool->ReleaseActor(&Actor))
+	{
+		Actor.Destroy();
+	}
+}
+
+// Create a new inactive actor owned by the pool
+AActor* URCActorPoolSubsystem::CreateActor(UClass* ActorClass)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN_VALUE(World != nullptr, nullptr);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* Actor = World->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParams);
+	ASSERT_RETURN_VALUE(Actor != nullptr, nullptr);
+
+	// New actors start out released, the same as ones returned to the pool
+	PooledActors.Add(Actor);
+	IPoolableActorInterface::Execute_OnReleased(Actor);
+	SetActorActive(*Actor, false);
+	return Actor;
+}
+
+// Set whether a pooled actor is in the world
+void URCActorPoolSubsystem::SetActorActive(AActor& Actor, bool bActive)
+{
+	// Don't let a lifespan destroy an inactive actor
+	if (!bActive)
+	{
+		Actor.SetLifeSpan(0);
+	}
+
+	Actor.SetActorHiddenInGame(!bActive);
+	Actor.SetActorEnableCollision(bActive);
+	Actor.SetActorTickEnabled(bActive && Actor.PrimaryActorTick.bStartWithTickEnabled);
+
+	// Components like movement keep ticking on their own when only the actor's tick is disabled
+	TInlineComponentArray<UActorComponent*> Components(&Actor);
+	for (UActorComponent* Component : Components)
+	{
+		Component->SetComponentTickEnabled(bActive && Component->PrimaryComponentTick.bStartWithTickEnabled);
+	}
+}
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RCActorPoolSubsystem.generated.h"
+
+/**
+ * Actors waiting to be reused for a single class
+ */
+USTRUCT()
+struct FRCActorPool
+{
+	GENERATED_BODY()
+
+	// Actors that are inactive and ready to be acquired
+	UPROPERTY()
+	TArray<AActor*> AvailableActors;
+};
+
+/**
+ * Keeps short lived actors around to be reused instead of destroying them and spawning new ones.
+ * Only classes implementing IPoolableActorInterface are pooled, anything else is spawned and destroyed as normal
+ */
+UCLASS()
+class RC_API URCActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Make sure there are enough inactive actors of a class ready to be acquired
+	 * @param ActorClass	The class of actor to create
+	 * @param Count			The number of actors that should be available
+	 */
+	UFUNCTION(BlueprintCallable)
+	void PrewarmActors(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/**
+	 * Spawn an actor, reusing one from the pool if the class is poolable
+	 *
+	 * @param ActorClass	The class of actor to spawn
+	 * @param Transform		Where to spawn the actor
+	 * @param Owner			The owner of the actor
+	 * @param Instigator	The instigator of the actor
+	 * Returns the actor
+	 */
+	AActor* AcquireActor(TSubclassOf<AActor> ActorClass, const FTransform& Transform, AActor* Owner = nullptr, APawn* Instigator = nullptr);
+
+	/**
+	 * Return an actor to the pool
+	 * @param Actor	The actor to release
+	 * Returns false if the actor isn't owned by the pool and should be destroyed instead
+	 */
+	bool ReleaseActor(AActor* Actor);
+
+	/**
+	 * Return an actor to the pool if it's owned by it, otherwise destroy it
+	 * @param Actor	The actor to be done with
+	 */
+	static void ReleaseOrDestroyActor(AActor& Actor);
+
+private:
+	/**
+	 * Create a new inactive actor owned by the pool
+	 * @param ActorClass	The class of actor to create
+	 * Returns the actor
+	 */
+	AActor* CreateActor(UClass* ActorClass);
+
+	/**
+	 * Set whether a pooled actor is in the world
+	 * @param Actor		The actor to change
+	 * @param bActive	Whether the actor should be active
+	 */
+	static void SetActorActive(AActor& Actor, bool bActive);
+
+	// Pools of each class
+	UPROPERTY()
+	TMap<UClass*, FRCActorPool> Pools;
+
+	// Every actor owned by the pool, acquired or not
+	UPROPERTY()
+	TSet<AActor*> PooledActors;
+};
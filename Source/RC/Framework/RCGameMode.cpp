@@ -11,17 +11,25 @@
 #include "UObject/ConstructorHelpers.h"
 
 #include "RC/Characters/Components/HealthComponent.h"
+#include "RC/Characters/Components/InventoryComponent.h"
+#include "RC/Characters/Enemies/BaseEnemy.h"
+#include "RC/Characters/Enemies/EnemyPoolSubsystem.h"
 #include "RC/Characters/Player/RCCharacter.h"
 #include "RC/Characters/Player/RCPlayerState.h"
 #include "RC/Debug/Debug.h"
+#include "RC/Framework/RCActorPoolSubsystem.h"
 #include "RC/Framework/RCGameInstance.h"
 #include "RC/Save/RCSaveGame.h"
 #include "RC/Save/SaveGameInterface.h"
+#include "RC/Util/RCStatics.h"
+#include "RC/Weapons/RCWeaponTypes.h"
 
 void ARCGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
 	Super::InitGame(MapName, Options, ErrorMessage);
 
+	PreloadDefaultLoadout();
+
 	URCGameInstance* GameInstance = GetGameInstance<URCGameInstance>();
 	ASSERT_RETURN(GameInstance != nullptr);
 	
@@ -36,6 +44,34 @@ void ARCGameMode::InitGame(const FString& MapName, const FString& Options, FStri
 	}
 }
 
+// Prewarm the enemy and actor pools as play starts
+void ARCGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	// Pools are prewarmed once play has started so their actors begin play as they're spawned and are deactivated right after.
+	// Otherwise their BeginPlay would be deferred until after the pool had deactivated them, undoing it
+	UEnemyPoolSubsystem* EnemyPool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+	ASSERT(EnemyPool != nullptr);
+	if (EnemyPool != nullptr)
+	{
+		for (const TPair<TSubclassOf<ABaseEnemy>, int32>& PoolSize : EnemyPoolSizes)
+		{
+			EnemyPool->PrewarmEnemies(PoolSize.Key, PoolSize.Value);
+		}
+	}
+
+	URCActorPoolSubsystem* ActorPool = GetWorld()->GetSubsystem<URCActorPoolSubsystem>();
+	ASSERT(ActorPool != nullptr);
+	if (ActorPool != nullptr)
+	{
+		for (const TPair<TSubclassOf<AActor>, int32>& PoolSize : ActorPoolSizes)
+		{
+			ActorPool->PrewarmActors(PoolSize.Key, PoolSize.Value);
+		}
+	}
+}
+
 // Called when a new player is spawned
 void ARCGameMode::HandleStartingNewPlayer_Implementation(APlayerController* NewPlayer)
 {
@@ -224,3 +260,45 @@ void ARCGameMode::OnPlayerDied(AActor * Player)
 		},
 		1, false);
 }
+
+// Start streaming the weapons in the default pawn's loadout so they're resident before they're first equipped
+void ARCGameMode::PreloadDefaultLoadout()
+{
+	const ARCCharacter* DefaultPlayer = DefaultPawnClass != nullptr ? Cast<ARCCharacter>(DefaultPawnClass->GetDefaultObject()) : nullptr;
+	const UInventoryComponent* DefaultInventory = DefaultPlayer != nullptr ? DefaultPlayer->GetInventory() : nullptr;
+	if (DefaultInventory == nullptr)
+	{
+		OnDefaultLoadoutPreloaded();
+		return;
+	}
+
+	TArray<FPrimaryAssetId> WeaponInfoIds;
+	for (const FLoadoutSlotInfo& LoadoutSlotInfo : DefaultInventory->GetDefaultLoadout().LoadoutSlotInfos)
+	{
+		if (LoadoutSlotInfo.WeaponInfoId.IsValid())
+		{
+			WeaponInfoIds.AddUnique(LoadoutSlotInfo.WeaponInfoId);
+		}
+	}
+
+	// The weapon classes, montages and ammo are hard references of the infos so they stream in with them, the icons come from the UI bundle
+	LoadoutPreloadHandle = URCStatics::LoadPrimaryAssets(WeaponInfoIds, FStreamableDelegate::CreateUObject(this, &ARCGameMode::OnDefaultLoadoutPreloaded), { UPlayerWeaponInfo::UIBundle });
+
+	// Nothing needed to be streamed
+	if (!LoadoutPreloadHandle.IsValid())
+	{
+		OnDefaultLoadoutPreloaded();
+	}
+}
+
+// Called once the default loadout has finished streaming in
+void ARCGameMode::OnDefaultLoadoutPreloaded()
+{
+	if (bLoadoutPreloaded)
+	{
+		return;
+	}
+
+	bLoadoutPreloaded = true;
+	LoadoutPreloadedDelegate.Broadcast();
+}
@@ -6,6 +6,9 @@
 #include "GameFramework/GameModeBase.h"
 #include "RCGameMode.generated.h"
 
+// Broadcasted when the player's default loadout has finished streaming in
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLoadoutPreloaded);
+
 /**
  * Default game mode
  */
@@ -23,6 +26,9 @@ public:
 	 */
 	void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
+	// Prewarm the enemy and actor pools as play starts
+	void StartPlay() override;
+
 	/**
 	 * Called when a new player is spawned
 	 * Load in the level transition persistent data if we were loading a level
@@ -41,6 +47,13 @@ public:
 	// Useful for when theres data to save for an actor that's being deleted
 	void SaveActorForLevelTransition(AActor* Actor);
 
+	// Whether the player's default loadout has finished streaming in
+	UFUNCTION(BlueprintPure)
+	bool IsLoadoutPreloaded() const { return bLoadoutPreloaded; }
+
+	// Get the Loadout Preloaded delegate
+	FOnLoadoutPreloaded& OnLoadoutPreloaded() { return LoadoutPreloadedDelegate; }
+
 protected:
 	/**
 	 * Called when the player has died
@@ -55,7 +68,31 @@ protected:
 	// Load the data we saved for transitioning between or reseting levels
 	void LoadLevelTransitionData();
 
+	// Start streaming the weapons in the default pawn's loadout along with their bundles so they're resident before they're first equipped
+	void PreloadDefaultLoadout();
+
+	// Called once the default loadout has finished streaming in
+	void OnDefaultLoadoutPreloaded();
+
 	// Current save
 	UPROPERTY()
 	class URCLevelTransitionSave* CurrentSave = nullptr;
+
+	// Number of each enemy class to have ready in the enemy pool when the level starts
+	UPROPERTY(EditDefaultsOnly, Category = Enemies)
+	TMap<TSubclassOf<class ABaseEnemy>, int32> EnemyPoolSizes;
+
+	// Number of each poolable actor class, such as bullets and hit effects, to have ready in the actor pool when the level starts
+	UPROPERTY(EditDefaultsOnly, Category = Pooling)
+	TMap<TSubclassOf<AActor>, int32> ActorPoolSizes;
+
+	// Handle keeping the preloaded loadout in memory
+	TSharedPtr<struct FStreamableHandle> LoadoutPreloadHandle;
+
+	// Whether the player's default loadout has finished streaming in
+	bool bLoadoutPreloaded = false;
+
+	// Broadcasted when the player's default loadout has finished streaming in
+	UPROPERTY(BlueprintAssignable, Category = Loadout, meta = (AllowPrivateAccess))
+	FOnLoadoutPreloaded LoadoutPreloadedDelegate;
 };
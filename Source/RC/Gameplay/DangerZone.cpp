@@ -7,6 +7,7 @@
 #include "RC/Characters/BaseCharacter.h"
 #include "RC/Debug/Debug.h"
 #include "RC/Framework/DamageInterface.h"
+#include "RC/Framework/DamageSubsystem.h"
 #include "RC/Util/RCStatics.h"
 
 // Sets default values
@@ -37,19 +38,25 @@ void ADangerZone::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	UDamageSubsystem* DamageSubsystem = World->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
+
 	// Go through each actor inside
 	FDamageRequestParams Params;
 	Params.Damage = DamageEachTick;
 	Params.DamageType = EDamageTypes::NORMAL;
 	for (AActor* Actor : ActorsInside)
 	{
+		ASSERT_CONTINUE(Actor != nullptr);
+
 		// Deal damage if we do each tick
 		if (bDealsDamageEachTick)
 		{
-			IDamageInterface* DamageableActor = Cast<IDamageInterface>(Actor);
-			ASSERT_CONTINUE(DamageableActor != nullptr);
-
-			DamageableActor->RequestDamage(Params);
+			const bool bQueued = DamageSubsystem->QueueDamage(*Actor, Params);
+			ASSERT_CONTINUE(bQueued);
 		}
 
 		// Apply impulse if we do each tick
@@ -79,12 +86,13 @@ void ADangerZone::OnDangerZoneEntered(UPrimitiveComponent*, AActor* OtherActor,
 	ActorsInside.Add(OtherActor);
 
 	// Deal damage
-	if (bDealsDamageOnEnter)
+	UDamageSubsystem* DamageSubsystem = GetWorld()->GetSubsystem<UDamageSubsystem>();
+	if (bDealsDamageOnEnter && DamageSubsystem != nullptr)
 	{
 		FDamageRequestParams Params;
 		Params.Damage = DamageOnEnter;
 		Params.DamageType = EDamageTypes::NORMAL;
-		DamageableActor->RequestDamage(Params);
+		DamageSubsystem->QueueDamage(*OtherActor, Params);
 	}
 
 	// Stop their movement
@@ -4,6 +4,7 @@
 #include "Components/StaticMeshComponent.h"
 
 #include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageableGridSubsystem.h"
 #include "RC/Gameplay/Destructibles/DestructibleComponent.h"
 
 ABaseDestructible::ABaseDestructible()
@@ -29,6 +30,28 @@ void ABaseDestructible::Serialize(FArchive& Ar)
 	}
 }
 
+// Start being tracked as a damageable target
+void ABaseDestructible::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UDamageableGridSubsystem* DamageableGrid = GetWorld()->GetSubsystem<UDamageableGridSubsystem>();
+	ASSERT_RETURN(DamageableGrid != nullptr);
+	DamageableGrid->RegisterDamageable(*this);
+}
+
+// Stop being tracked as a damageable target
+void ABaseDestructible::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	UDamageableGridSubsystem* DamageableGrid = GetWorld()->GetSubsystem<UDamageableGridSubsystem>();
+	if (DamageableGrid != nullptr)
+	{
+		DamageableGrid->UnregisterDamageable(*this);
+	}
+}
+
 // Request for this character to be damaged
 void ABaseDestructible::RequestDamage(FDamageRequestParams& Params)
 {
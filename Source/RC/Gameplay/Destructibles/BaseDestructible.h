@@ -41,6 +41,13 @@ public:
 	/** Returns Mesh subobject **/
 	FORCEINLINE class UStaticMeshComponent* GetMesh() const { return Mesh; }
 
+protected:
+	// Start being tracked as a damageable target
+	void BeginPlay() override;
+
+	// Stop being tracked as a damageable target
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** Destructible */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Destructible, meta = (AllowPrivateAccess = "true"))
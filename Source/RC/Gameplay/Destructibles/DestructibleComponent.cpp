@@ -4,6 +4,7 @@
 #include "Kismet/GameplayStatics.h"
 
 #include "RC/Debug/Debug.h"
+#include "RC/Framework/RCActorPoolSubsystem.h"
 #include "RC/Framework/RCGameMode.h"
 
 // Save the destructible
@@ -50,11 +51,11 @@ void UDestructibleComponent::Destroy()
 		UWorld* World = GetWorld();
 		ASSERT_RETURN(World != nullptr);
 
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Owner = Owner;
-		SpawnParams.bNoFail = true;
+		URCActorPoolSubsystem* ActorPool = World->GetSubsystem<URCActorPoolSubsystem>();
+		ASSERT_RETURN(ActorPool != nullptr);
+
 		FTransform SpawnTransform = Owner->GetActorTransform();
-		World->SpawnActor<AActor>(HuskClass, SpawnTransform, SpawnParams);
+		ActorPool->AcquireActor(HuskClass, SpawnTransform, Owner);
 	}
 
 	bIsDestroyed = true;
@@ -51,10 +51,18 @@ ARCPlayerState* URCStatics::GetPlayerState(const UObject* WorldContextObject)
 	return Cast<ARCPlayerState>(GameState->PlayerArray[0]);
 }
 
-TSharedPtr<FStreamableHandle> URCStatics::LoadPrimaryAsset(const FPrimaryAssetId& AssetId, FStreamableDelegate DelegateToCall)
+// Async load a primary asset
+TSharedPtr<FStreamableHandle> URCStatics::LoadPrimaryAsset(const FPrimaryAssetId& AssetId, FStreamableDelegate DelegateToCall, const TArray<FName>& Bundles/* = TArray<FName>()*/)
 {
 	UAssetManager* Manager = UAssetManager::GetIfValid();
-	return Manager != nullptr ? Manager->LoadPrimaryAsset(AssetId, TArray<FName>(), MoveTemp(DelegateToCall)) : nullptr;
+	return Manager != nullptr ? Manager->LoadPrimaryAsset(AssetId, Bundles, MoveTemp(DelegateToCall)) : nullptr;
+}
+
+// Async load several primary assets with a single handle
+TSharedPtr<FStreamableHandle> URCStatics::LoadPrimaryAssets(const TArray<FPrimaryAssetId>& AssetIds, FStreamableDelegate DelegateToCall, const TArray<FName>& Bundles/* = TArray<FName>()*/)
+{
+	UAssetManager* Manager = UAssetManager::GetIfValid();
+	return Manager != nullptr ? Manager->LoadPrimaryAssets(AssetIds, Bundles, MoveTemp(DelegateToCall)) : nullptr;
 }
 
 // Keep the camera in place
@@ -84,7 +84,23 @@ public:
 	template<typename AssetClass>
 	static const AssetClass* GetPrimaryAssetObject(const FPrimaryAssetId& AssetId);
 
-	static TSharedPtr<FStreamableHandle> LoadPrimaryAsset(const FPrimaryAssetId& AssetId, FStreamableDelegate DelegateToCall);
+	/**
+	 * Async load a primary asset
+	 * @param AssetId			The ID of the asset to load
+	 * @param DelegateToCall	Called once the asset has loaded
+	 * @param Bundles			The asset bundles to load along with the asset
+	 * @Return The handle of the load, null if there was nothing to load
+	 */
+	static TSharedPtr<FStreamableHandle> LoadPrimaryAsset(const FPrimaryAssetId& AssetId, FStreamableDelegate DelegateToCall, const TArray<FName>& Bundles = TArray<FName>());
+
+	/**
+	 * Async load several primary assets with a single handle
+	 * @param AssetIds			The IDs of the assets to load
+	 * @param DelegateToCall	Called once every asset has loaded
+	 * @param Bundles			The asset bundles to load along with the assets
+	 * @Return The handle of the load, null if there was nothing to load
+	 */
+	static TSharedPtr<FStreamableHandle> LoadPrimaryAssets(const TArray<FPrimaryAssetId>& AssetIds, FStreamableDelegate DelegateToCall, const TArray<FName>& Bundles = TArray<FName>());
 
 	// Trigger values
 	const static float TriggerStatusHalfMin;
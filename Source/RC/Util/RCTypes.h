@@ -36,6 +36,18 @@ enum class EAIState : uint8
 	NUM_STATES	UMETA(Hidden)
 };
 
+/**
+ * Perception profiles AI switch between depending on their state
+ */
+UENUM(BlueprintType, Category = "AI")
+enum class EAIPerceptionProfile : uint8
+{
+	Patrol		UMETA(DisplayName = "Patrol"),
+	Combat		UMETA(DisplayName = "Combat"),
+
+	NUM_PROFILES	UMETA(Hidden)
+};
+
 /**
  * Inventory slots for the player
  */
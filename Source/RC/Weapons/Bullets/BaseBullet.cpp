@@ -6,9 +6,9 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 
 #include "RC/Characters/BaseCharacter.h"
-#include "RC/Characters/Components/StatusEffectComponent.h"
 #include "RC/Debug/Debug.h"
-#include "RC/Framework/DamageInterface.h"
+#include "RC/Framework/DamageSubsystem.h"
+#include "RC/Framework/RCActorPoolSubsystem.h"
 #include "RC/Weapons/Bullets/BaseBulletHitEffect.h"
 #include "RC/Weapons/Weapons/BaseWeapon.h"
 #include "RC/Util/DataSingleton.h"
@@ -68,13 +68,42 @@ void ABaseBullet::Init(const FBulletData& InBulletData)
 {
 	BulletData = InBulletData;
 	ABaseWeapon* WeaponObj = BulletData.Weapon.Get();
-	if (WeaponObj != nullptr)
+	if (!BulletData.WeaponId.IsValid() && WeaponObj != nullptr)
 	{
-		WeaponId = WeaponObj->GetInfoId();
+		BulletData.WeaponId = WeaponObj->GetInfoId();
 	}
 
 	ASSERT_RETURN(Movement != nullptr);
 	Movement->Velocity = BulletData.Direction * Movement->InitialSpeed;
+
+	// Make up for being shot late by moving as far as it would have already gone
+	if (BulletData.TimeOffset > 0)
+	{
+		FHitResult Hit;
+		SetActorLocation(GetActorLocation() + Movement->Velocity * BulletData.TimeOffset, true, &Hit);
+		if (Hit.bBlockingHit)
+		{
+			OnImpact(Hit);
+		}
+	}
+}
+
+// Reset the movement after being reused from the actor pool
+void ABaseBullet::OnAcquired_Implementation()
+{
+	// Stopping clears the updated component
+	Movement->SetUpdatedComponent(Collision);
+
+	Collision->MoveIgnoreActors.Reset();
+	Collision->MoveIgnoreActors.Add(GetInstigator());
+	Collision->MoveIgnoreActors.Add(GetOwner());
+}
+
+// Stop moving while waiting in the actor pool
+void ABaseBullet::OnReleased_Implementation()
+{
+	Movement->StopMovementImmediately();
+	Movement->SetUpdatedComponent(nullptr);
 }
 
 // Handle hit
@@ -82,45 +111,41 @@ void ABaseBullet::OnImpact(const FHitResult& HitResult)
 {
 	Movement->StopMovementImmediately();
 
-	const TWeakObjectPtr<AActor> HitActor = HitResult.Actor;
-	if (HitActor != nullptr)
+	UWorld* World = GetWorld();
+	if (World != nullptr)
 	{
-		IDamageInterface* DamageableActor = Cast<IDamageInterface>(HitActor);
-		if (DamageableActor != nullptr)
-		{
-			// Request damage on hit
-			FDamageRequestParams DamageParams;
-			DamageParams.bFromPlayer = URCStatics::IsActorPlayer(BulletData.Shooter.Get());
-			DamageParams.Damage = BulletData.Damage;
-			DamageParams.DamageType = BulletData.DamageType;
-			DamageParams.Instigator = BulletData.Shooter;
-			DamageParams.CauseId = WeaponId;
-			DamageParams.HitLocation = HitResult.ImpactPoint;
-			DamageParams.HitNormal = HitResult.Normal;
-			DamageableActor->RequestDamage(DamageParams);
-		}
+		ApplyImpact(*World, BulletData, HitEffectClass, HitResult);
+	}
 
-		// Give status effect
-		if (BulletData.TimedStatusEffectClass != NULL)
-		{
-			UStatusEffectComponent* StatusEffectComponent = HitActor->FindComponentByClass<UStatusEffectComponent>();
-			if (StatusEffectComponent != nullptr)
-			{
-				FStatusEffectTimedRequest TimedRequest(BulletData.TimedStatusEffectClass, BulletData.TimedStatusEffectDuration);
-				StatusEffectComponent->AddStatusEffectTimed(TimedRequest);
-			}
-		}
+	URCActorPoolSubsystem::ReleaseOrDestroyActor(*this);
+}
+
+// Damage and apply status effects to what was hit, then spawn the hit effect
+void ABaseBullet::ApplyImpact(UWorld& World, const FBulletData& BulletData, TSubclassOf<ABaseBulletHitEffect> HitEffectClass, const FHitResult& HitResult)
+{
+	AActor* HitActor = HitResult.GetActor();
+	UDamageSubsystem* DamageSubsystem = World.GetSubsystem<UDamageSubsystem>();
+	if (HitActor != nullptr && DamageSubsystem != nullptr)
+	{
+		// Request damage on hit and give status effect
+		FDamageRequestParams DamageParams;
+		DamageParams.bFromPlayer = URCStatics::IsActorPlayer(BulletData.Shooter.Get());
+		DamageParams.Damage = BulletData.Damage;
+		DamageParams.DamageType = BulletData.DamageType;
+		DamageParams.Instigator = BulletData.Shooter;
+		DamageParams.CauseId = BulletData.WeaponId;
+		DamageParams.HitLocation = HitResult.ImpactPoint;
+		DamageParams.HitNormal = HitResult.Normal;
+		DamageSubsystem->QueueDamage(*HitActor, DamageParams, BulletData.TimedStatusEffectClass, BulletData.TimedStatusEffectDuration);
 	}
 
 	// Spawn effect
 	if (HitEffectClass != nullptr)
 	{
-		UWorld* World = GetWorld();
-		ASSERT_RETURN(World != nullptr);
+		URCActorPoolSubsystem* ActorPool = World.GetSubsystem<URCActorPoolSubsystem>();
+		ASSERT_RETURN(ActorPool != nullptr);
 
 		FTransform EffectTransform(FRotationMatrix::MakeFromZ(HitResult.ImpactNormal).Rotator(), HitResult.ImpactPoint);
-		World->SpawnActor<ABaseBulletHitEffect>(HitEffectClass, EffectTransform);
+		ActorPool->AcquireActor(HitEffectClass, EffectTransform);
 	}
-
-	Destroy();
 }
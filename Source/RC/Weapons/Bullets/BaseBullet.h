@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 
+#include "RC/Framework/PoolableActorInterface.h"
 #include "RC/Weapons/RCWeaponTypes.h"
 
 #include "BaseBullet.generated.h"
@@ -13,7 +14,7 @@
  * Base bullet to spawn from a weapon when shot
  */
 UCLASS(Abstract, Blueprintable)
-class RC_API ABaseBullet : public AActor
+class RC_API ABaseBullet : public AActor, public IPoolableActorInterface
 {
 	GENERATED_BODY()
 	
@@ -29,10 +30,35 @@ public:
 	 */
 	void Init(const FBulletData& InBulletData);
 
+	// Reset the movement after being reused from the actor pool
+	void OnAcquired_Implementation() override;
+
+	// Stop moving while waiting in the actor pool
+	void OnReleased_Implementation() override;
+
 	// Handle hit
 	UFUNCTION()
 	void OnImpact(const FHitResult& HitResult);
 
+	/**
+	 * Damage and apply status effects to what was hit, then spawn the hit effect
+	 *
+	 * @param World				The world the bullet is in
+	 * @param BulletData		The data of the bullet that hit
+	 * @param HitEffectClass	The effect to spawn at the hit
+	 * @param HitResult			The hit
+	 */
+	static void ApplyImpact(UWorld& World, const FBulletData& BulletData, TSubclassOf<class ABaseBulletHitEffect> HitEffectClass, const FHitResult& HitResult);
+
+	// Whether bullets of this class are simulated together by the projectile subsystem instead of being spawned as actors
+	bool IsBatchSimulated() const { return bBatchSimulated; }
+
+	// Whether batch simulated bullets of this class sweep against complex collision
+	bool ShouldBatchTraceComplex() const { return bBatchTraceComplex; }
+
+	// Get the effect to spawn when hit
+	TSubclassOf<class ABaseBulletHitEffect> GetHitEffectClass() const { return HitEffectClass; }
+
 	// Returns static mesh subobject
 	FORCEINLINE class UStaticMeshComponent* GetMesh() const { return Mesh; }
 	// Returns Movement subobject
@@ -57,9 +83,15 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Projectile, meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<class ABaseBulletHitEffect> HitEffectClass;
 
+	// Whether bullets of this class are simulated together by the projectile subsystem and drawn as instances instead of being spawned as actors.
+	// Only the mesh, collision and movement settings of this class are used, anything else added to it won't be
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Batching", meta = (AllowPrivateAccess = "true"))
+	bool bBatchSimulated = false;
+
+	// Whether batch simulated bullets sweep against complex collision instead of simple
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile|Batching", meta = (AllowPrivateAccess = "true", EditCondition = "bBatchSimulated"))
+	bool bBatchTraceComplex = false;
+
 	// Bullet data
 	FBulletData BulletData;
-
-	// The Asset Id of the weapon that shot this
-	FPrimaryAssetId WeaponId = FPrimaryAssetId();
 };
@@ -5,6 +5,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "Particles/ParticleSystemComponent.h"
 
+#include "RC/Framework/RCActorPoolSubsystem.h"
+
 ABaseBulletHitEffect::ABaseBulletHitEffect()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
@@ -12,11 +14,9 @@ ABaseBulletHitEffect::ABaseBulletHitEffect()
 
 }
 
-// Called when the game starts or when spawned
-void ABaseBulletHitEffect::BeginPlay()
+// Start the effect when taken from the actor pool
+void ABaseBulletHitEffect::OnAcquired_Implementation()
 {
-	Super::BeginPlay();
-
 	// Spawn emitter
 	if (ExplosionFX)
 	{
@@ -27,6 +27,16 @@ void ABaseBulletHitEffect::BeginPlay()
 	SetLifeSpan(Lifetime);
 }
 
+// Stop the effect when returned to the actor pool
+void ABaseBulletHitEffect::OnReleased_Implementation()
+{
+	if (SpawnedFX)
+	{
+		SpawnedFX->Deactivate();
+		SpawnedFX = nullptr;
+	}
+}
+
 void ABaseBulletHitEffect::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	if (SpawnedFX)
@@ -36,3 +46,9 @@ void ABaseBulletHitEffect::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	Super::EndPlay(EndPlayReason);
 }
+
+// Return to the actor pool instead of being destroyed
+void ABaseBulletHitEffect::LifeSpanExpired()
+{
+	URCActorPoolSubsystem::ReleaseOrDestroyActor(*this);
+}
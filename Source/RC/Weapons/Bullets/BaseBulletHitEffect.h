@@ -4,27 +4,37 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+
+#include "RC/Framework/PoolableActorInterface.h"
+
 #include "BaseBulletHitEffect.generated.h"
 
 /**
  * Effect to spawn when a bullet hits an actor
  */
 UCLASS(Abstract, Blueprintable)
-class RC_API ABaseBulletHitEffect : public AActor
+class RC_API ABaseBulletHitEffect : public AActor, public IPoolableActorInterface
 {
 	GENERATED_BODY()
 	
 public:	
 	ABaseBulletHitEffect();
 
+	// Start the effect when taken from the actor pool
+	void OnAcquired_Implementation() override;
+
+	// Stop the effect when returned to the actor pool
+	void OnReleased_Implementation() override;
+
 	// Returns exploxion fx subobject
 	FORCEINLINE class UParticleSystem* GetExplosionFX() const { return ExplosionFX; }
 
 protected:
-	// Called when the game starts or when spawned
-	void BeginPlay() override;
 	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	// Return to the actor pool instead of being destroyed
+	void LifeSpanExpired() override;
+
 	// Explosion FX
 	UPROPERTY(EditDefaultsOnly, Category = Effect, meta = (AllowPrivateAccess = "true"))
 	UParticleSystem* ExplosionFX;
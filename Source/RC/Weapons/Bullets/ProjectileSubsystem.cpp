@@ -0,0 +1,244 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "ProjectileSubsystem.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+#include "RC/Debug/Debug.h"
+#include "RC/Weapons/Bullets/BaseBullet.h"
+#include "RC/Weapons/Bullets/BaseBulletHitEffect.h"
+#include "RC/Weapons/Weapons/BaseWeapon.h"
+
+const float UProjectileSubsystem::MaxLifetime = 5.0f;
+
+// Move the projectiles and resolve their impacts
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	for (TPair<UClass*, FProjectileBatch>& Batch : Batches)
+	{
+		TickBatch(*World, Batch.Value, DeltaTime);
+		UpdateInstances(Batch.Value);
+	}
+
+	// Apply impacts after everything has moved so damage can't change the batches while they're being iterated
+	for (const FProjectileImpact& Impact : Impacts)
+	{
+		ABaseBullet::ApplyImpact(*World, Impact.BulletData, Impact.HitEffectClass, Impact.Hit);
+	}
+	Impacts.Reset();
+}
+
+// Shoot a projectile
+bool UProjectileSubsystem::SpawnProjectile(TSubclassOf<ABaseBullet> BulletClass, const FTransform& Transform, const FBulletData& BulletData, AActor* Owner)
+{
+	return SpawnProjectiles(BulletClass, Transform, BulletData, MakeArrayView(&BulletData.Direction, 1), Owner);
+}
+
+// Shoot projectiles that share everything but their direction
+bool UProjectileSubsystem::SpawnProjectiles(TSubclassOf<ABaseBullet> BulletClass, const FTransform& Transform, const FBulletData& BulletData, TArrayView<const FVector> Directions, AActor* Owner)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN_VALUE(World != nullptr, false);
+
+	FProjectileBatch* Batch = FindOrCreateBatch(BulletClass);
+	ASSERT_RETURN_VALUE(Batch != nullptr, false);
+
+	FBulletData SharedData = BulletData;
+	ABaseWeapon* Weapon = SharedData.Weapon.Get();
+	if (!SharedData.WeaponId.IsValid() && Weapon != nullptr)
+	{
+		SharedData.WeaponId = Weapon->GetInfoId();
+	}
+
+	const int32 FirstIndex = Batch->Locations.Num();
+	const int32 NumShot = Directions.Num();
+	Batch->Locations.Reserve(FirstIndex + NumShot);
+	Batch->Velocities.Reserve(FirstIndex + NumShot);
+	Batch->Ages.Reserve(FirstIndex + NumShot);
+	Batch->Owners.Reserve(FirstIndex + NumShot);
+	Batch->BulletData.Reserve(FirstIndex + NumShot);
+
+	const FVector Location = Transform.GetLocation();
+	for (const FVector& Direction : Directions)
+	{
+		Batch->Locations.Add(Location);
+		Batch->Velocities.Add(Direction * Batch->Speed);
+		Batch->Ages.Add(0.0f);
+		Batch->Owners.Add(Owner);
+
+		FBulletData& Data = Batch->BulletData.Add_GetRef(SharedData);
+		Data.Direction = Direction;
+	}
+
+	NumProjectiles += NumShot;
+
+	// Make up for being shot late by moving as far as they would have already gone. Walk backwards so removing one doesn't move the rest
+	if (SharedData.TimeOffset > 0)
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), Batch->bTraceComplex);
+		for (int32 Index = FirstIndex + NumShot - 1; Index >= FirstIndex; --Index)
+		{
+			if (MoveProjectile(*World, *Batch, Index, SharedData.TimeOffset, QueryParams))
+			{
+				RemoveProjectile(*Batch, Index);
+			}
+		}
+	}
+	return true;
+}
+
+// Get the batch for a bullet class, creating it if needed
+FProjectileBatch* UProjectileSubsystem::FindOrCreateBatch(TSubclassOf<ABaseBullet> BulletClass)
+{
+	UClass* BulletClassObj = BulletClass.Get();
+	ASSERT_RETURN_VALUE(BulletClassObj != nullptr, nullptr);
+
+	FProjectileBatch* Batch = Batches.Find(BulletClassObj);
+	if (Batch != nullptr)
+	{
+		return Batch;
+	}
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN_VALUE(World != nullptr, nullptr);
+
+	// Take the settings from the bullet's defaults
+	const ABaseBullet* DefaultBullet = BulletClassObj->GetDefaultObject<ABaseBullet>();
+	ASSERT_RETURN_VALUE(DefaultBullet != nullptr, nullptr);
+	const USphereComponent* Collision = DefaultBullet->GetCollision();
+	const UProjectileMovementComponent* Movement = DefaultBullet->GetMovement();
+	const UStaticMeshComponent* Mesh = DefaultBullet->GetMesh();
+	ASSERT_RETURN_VALUE(Collision != nullptr && Movement != nullptr && Mesh != nullptr, nullptr, "Bullet %s is missing a component", *BulletClassObj->GetName());
+
+	if (InstancesOwner == nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		InstancesOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		ASSERT_RETURN_VALUE(InstancesOwner != nullptr, nullptr);
+
+		USceneComponent* Root = NewObject<USceneComponent>(InstancesOwner);
+		InstancesOwner->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	Batch = &Batches.Add(BulletClassObj);
+	Batch->HitEffectClass = DefaultBullet->GetHitEffectClass();
+	Batch->MeshTransform = Mesh->GetRelativeTransform();
+	Batch->Radius = Collision->GetScaledSphereRadius();
+	Batch->Speed = Movement->InitialSpeed;
+	Batch->GravityZ = World->GetGravityZ() * Movement->ProjectileGravityScale;
+	Batch->bTraceComplex = DefaultBullet->ShouldBatchTraceComplex();
+	Batch->CollisionChannel = Collision->GetCollisionObjectType();
+	Batch->ResponseParams = FCollisionResponseParams(Collision->GetCollisionResponseToChannels());
+
+	// Every projectile of the class is drawn as an instance of the same mesh
+	Batch->Instances = NewObject<UInstancedStaticMeshComponent>(InstancesOwner);
+	Batch->Instances->SetMobility(EComponentMobility::Movable);
+	Batch->Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Batch->Instances->SetStaticMesh(Mesh->GetStaticMesh());
+	for (int32 MaterialIndex = 0; MaterialIndex < Mesh->GetNumMaterials(); ++MaterialIndex)
+	{
+		Batch->Instances->SetMaterial(MaterialIndex, Mesh->GetMaterial(MaterialIndex));
+	}
+	Batch->Instances->SetupAttachment(InstancesOwner->GetRootComponent());
+	Batch->Instances->RegisterComponent();
+
+	return Batch;
+}
+
+// Move every projectile in a batch, removing any that hit something or have expired
+void UProjectileSubsystem::TickBatch(const UWorld& World, FProjectileBatch& Batch, float DeltaTime)
+{
+	// Shared by every sweep in the batch, only the ignored actors change between projectiles
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), Batch.bTraceComplex);
+
+	// Backwards so finished projectiles can be swapped out
+	for (int32 Index = Batch.Locations.Num() - 1; Index >= 0; --Index)
+	{
+		if (MoveProjectile(World, Batch, Index, DeltaTime, QueryParams))
+		{
+			RemoveProjectile(Batch, Index);
+		}
+	}
+}
+
+// Move a single projectile, queueing its impact if it hit something
+bool UProjectileSubsystem::MoveProjectile(const UWorld& World, FProjectileBatch& Batch, int32 Index, float DeltaTime, FCollisionQueryParams& QueryParams)
+{
+	Batch.Ages[Index] += DeltaTime;
+	Batch.Velocities[Index].Z += Batch.GravityZ * DeltaTime;
+
+	const FVector Start = Batch.Locations[Index];
+	const FVector End = Start + Batch.Velocities[Index] * DeltaTime;
+
+	// Don't hit who shot us
+	QueryParams.ClearIgnoredActors();
+	QueryParams.AddIgnoredActor(Batch.Owners[Index].Get());
+	QueryParams.AddIgnoredActor(Batch.BulletData[Index].Shooter.Get());
+
+	FHitResult Hit;
+	if (World.SweepSingleByChannel(Hit, Start, End, FQuat::Identity, Batch.CollisionChannel, FCollisionShape::MakeSphere(Batch.Radius), QueryParams, Batch.ResponseParams))
+	{
+		FProjectileImpact& Impact = Impacts.AddDefaulted_GetRef();
+		Impact.BulletData = Batch.BulletData[Index];
+		Impact.HitEffectClass = Batch.HitEffectClass;
+		Impact.Hit = Hit;
+		return true;
+	}
+
+	Batch.Locations[Index] = End;
+	return Batch.Ages[Index] >= MaxLifetime;
+}
+
+// Remove a projectile from its batch
+void UProjectileSubsystem::RemoveProjectile(FProjectileBatch& Batch, int32 Index)
+{
+	Batch.Locations.RemoveAtSwap(Index, 1, false);
+	Batch.Velocities.RemoveAtSwap(Index, 1, false);
+	Batch.Ages.RemoveAtSwap(Index, 1, false);
+	Batch.BulletData.RemoveAtSwap(Index, 1, false);
+	Batch.Owners.RemoveAtSwap(Index, 1, false);
+	--NumProjectiles;
+}
+
+// Move the batch's instances to where its projectiles are
+void UProjectileSubsystem::UpdateInstances(FProjectileBatch& Batch)
+{
+	ASSERT_RETURN(Batch.Instances != nullptr);
+
+	const int32 NumInstances = Batch.Instances->GetInstanceCount();
+	if (NumInstances == 0 && Batch.Locations.Num() == 0)
+	{
+		return;
+	}
+
+	// Match the number of instances to the number of projectiles
+	for (int32 Index = NumInstances; Index < Batch.Locations.Num(); ++Index)
+	{
+		Batch.Instances->AddInstance(FTransform::Identity);
+	}
+	for (int32 Index = NumInstances - 1; Index >= Batch.Locations.Num(); --Index)
+	{
+		Batch.Instances->RemoveInstance(Index);
+	}
+
+	if (Batch.Locations.Num() == 0)
+	{
+		return;
+	}
+
+	// Face the direction of travel like the bullet's rotation following its velocity
+	InstanceTransforms.Reset(Batch.Locations.Num());
+	for (int32 Index = 0; Index < Batch.Locations.Num(); ++Index)
+	{
+		const FTransform ProjectileTransform(FRotationMatrix::MakeFromX(Batch.Velocities[Index]).ToQuat(), Batch.Locations[Index]);
+		InstanceTransforms.Add(Batch.MeshTransform * ProjectileTransform);
+	}
+	Batch.Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+}
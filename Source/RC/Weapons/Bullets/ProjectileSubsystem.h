@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RC/Weapons/RCWeaponTypes.h"
+
+#include "ProjectileSubsystem.generated.h"
+
+/**
+ * Every simulated projectile of a single bullet class.
+ * Projectiles are stored across parallel arrays so the sweep loop runs over contiguous data
+ */
+USTRUCT()
+struct FProjectileBatch
+{
+	GENERATED_BODY()
+
+	// Draws every projectile in the batch
+	UPROPERTY()
+	class UInstancedStaticMeshComponent* Instances = nullptr;
+
+	// Effect to spawn when hit
+	UPROPERTY()
+	TSubclassOf<class ABaseBulletHitEffect> HitEffectClass;
+
+	// Transform of the mesh relative to the projectile
+	FTransform MeshTransform = FTransform::Identity;
+
+	// Radius of the projectile's collision
+	float Radius = 5.0f;
+
+	// Speed the projectile is shot at
+	float Speed = 0.0f;
+
+	// Gravity applied to the projectile
+	float GravityZ = 0.0f;
+
+	// Whether to sweep against complex collision
+	bool bTraceComplex = false;
+
+	// Channel the projectile sweeps on
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_WorldDynamic;
+
+	// What the projectile collides with
+	FCollisionResponseParams ResponseParams;
+
+	// Location of each projectile
+	TArray<FVector> Locations;
+
+	// Velocity of each projectile
+	TArray<FVector> Velocities;
+
+	// How long each projectile has been alive
+	TArray<float> Ages;
+
+	// Data of each projectile
+	TArray<FBulletData> BulletData;
+
+	// Actor that shot each projectile, either the weapon or the wielder itself
+	TArray<TWeakObjectPtr<AActor>> Owners;
+};
+
+/**
+ * Simulates bullets of batch simulated classes without spawning actors for them.
+ * Each class is moved with one sweep per projectile in a single loop and drawn through instanced meshes.
+ * Impacts behave the same as ABaseBullet::OnImpact
+ */
+UCLASS()
+class RC_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// FTickableGameObject implementation Begin
+	// Whether this subsystem should tick
+	virtual bool IsTickable() const override { return (NumProjectiles != 0 || Impacts.Num() != 0) && Super::IsTickable(); }
+
+	// Move the projectiles and resolve their impacts
+	virtual void Tick(float DeltaTime) override;
+
+	// Needed for tickables
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables); }
+	// FTickableGameObject implementation End
+
+	/**
+	 * Shoot a projectile
+	 *
+	 * @param BulletClass	The class of bullet to take the projectile's settings from
+	 * @param Transform		Where the projectile starts
+	 * @param BulletData	The data of the bullet. The direction is used for the projectile's velocity
+	 * @param Owner			The actor shooting the projectile, which it won't collide with
+	 * Returns true if the projectile was shot
+	 */
+	bool SpawnProjectile(TSubclassOf<class ABaseBullet> BulletClass, const FTransform& Transform, const FBulletData& BulletData, AActor* Owner);
+
+	/**
+	 * Shoot projectiles that share everything but their direction
+	 *
+	 * @param BulletClass	The class of bullet to take the projectiles' settings from
+	 * @param Transform		Where the projectiles start
+	 * @param BulletData	The data shared by the bullets. Its direction is ignored
+	 * @param Directions	The direction of each projectile
+	 * @param Owner			The actor shooting the projectiles, which they won't collide with
+	 * Returns true if the projectiles were shot
+	 */
+	bool SpawnProjectiles(TSubclassOf<class ABaseBullet> BulletClass, const FTransform& Transform, const FBulletData& BulletData, TArrayView<const FVector> Directions, AActor* Owner);
+
+private:
+	/**
+	 * A projectile that hit something this tick, applied once every projectile has moved
+	 */
+	struct FProjectileImpact
+	{
+		// Data of the bullet that hit
+		FBulletData BulletData;
+
+		// Effect to spawn at the hit
+		TSubclassOf<class ABaseBulletHitEffect> HitEffectClass;
+
+		// The hit
+		FHitResult Hit;
+	};
+
+	/**
+	 * Get the batch for a bullet class, creating it if needed
+	 * @param BulletClass	The class of bullet
+	 * Returns the batch, null if the class can't be batched
+	 */
+	FProjectileBatch* FindOrCreateBatch(TSubclassOf<class ABaseBullet> BulletClass);
+
+	/**
+	 * Move every projectile in a batch, removing any that hit something or have expired
+	 * @param World		The world to sweep in
+	 * @param Batch		The batch to move
+	 * @param DeltaTime	Time since the last tick
+	 */
+	void TickBatch(const UWorld& World, FProjectileBatch& Batch, float DeltaTime);
+
+	/**
+	 * Move a single projectile, queueing its impact if it hit something
+	 * @param World			The world to sweep in
+	 * @param Batch			The batch the projectile is in
+	 * @param Index			The index of the projectile in the batch
+	 * @param DeltaTime		Time to move the projectile for
+	 * @param QueryParams	Params of the batch's sweeps, the projectile's ignored actors are set on them
+	 * Returns true if the projectile hit something or expired and should be removed
+	 */
+	bool MoveProjectile(const UWorld& World, FProjectileBatch& Batch, int32 Index, float DeltaTime, FCollisionQueryParams& QueryParams);
+
+	/**
+	 * Remove a projectile from its batch
+	 * @param Batch		The batch the projectile is in
+	 * @param Index		The index of the projectile in the batch
+	 */
+	void RemoveProjectile(FProjectileBatch& Batch, int32 Index);
+
+	/**
+	 * Move the batch's instances to where its projectiles are
+	 * @param Batch		The batch to update
+	 */
+	void UpdateInstances(FProjectileBatch& Batch);
+
+	// Longest a projectile can fly before it's removed
+	static const float MaxLifetime;
+
+	// Batches of each bullet class
+	UPROPERTY()
+	TMap<UClass*, FProjectileBatch> Batches;
+
+	// Actor the instanced meshes are attached to
+	UPROPERTY()
+	AActor* InstancesOwner = nullptr;
+
+	// Impacts found this tick
+	TArray<FProjectileImpact> Impacts;
+
+	// Transforms of a batch's instances, kept around to avoid reallocating
+	TArray<FTransform> InstanceTransforms;
+
+	// Number of projectiles across every batch
+	int32 NumProjectiles = 0;
+};
@@ -5,6 +5,7 @@
 #include "RC/Util/RCStatics.h"
 #include "RC/Weapons/Weapons/PlayerWeapons/BasePlayerWeapon.h"
 
+const FName UPlayerWeaponInfo::UIBundle = FName(TEXT("UI"));
 
 // Set the default values the data should have
 void UPlayerWeaponData::SetDefaults(const FPrimaryAssetId& Id)
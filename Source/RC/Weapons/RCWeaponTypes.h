@@ -116,6 +116,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Attack)
 	float Cooldown = 0.5f;
 
+	// Whether the weapon's traces run asynchronously, with their results being resolved next frame
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Attack)
+	bool bAsyncTraces = false;
+
 	// Damage type
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Attack)
 	EDamageTypes DamageType = EDamageTypes::NORMAL;
@@ -178,6 +182,9 @@ public:
 	// Maximum levels
 	static constexpr uint8 MAX_LEVELS = 10;
 
+	// Asset bundle holding the soft references the UI needs
+	static const FName UIBundle;
+
 	// Info for each weapon level
 	UPROPERTY(EditDefaultsOnly, Category = Level)
 	FWeaponLevelInfo WeaponLevelConfigs[MAX_LEVELS];
@@ -191,7 +198,7 @@ public:
 	FName DisplayName;
 
 	// The icon for the weapon
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = UI)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = UI, meta = (AssetBundles = "UI"))
 	TSoftObjectPtr<class UTexture2D> IconTexture;
 
 	// Whether the weapon continue attacking if the trigger is still held down
@@ -212,6 +219,36 @@ public:
 	// ID of the ammo info
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile, Meta = (EditCondition = "bHasProjectile", EditConditionHides))
 	class UAmmoInfo* AmmoInfo;
+
+	// Whether the predicted arc of the projectile is shown while the trigger is half pulled
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Projectile, Meta = (EditCondition = "bHasProjectile", EditConditionHides))
+	bool bShowTrajectoryOnHalfTrigger = false;
+};
+
+/**
+ * Pattern of projectiles shot together in a single volley, like a shotgun spread or a triple shot
+ */
+UCLASS(BlueprintType)
+class RC_API UVolleyInfo : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Number of projectiles shot
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Volley, meta = (ClampMin = "1"))
+	int32 Count = 3;
+
+	// Angle in degrees from the aim to the edge of the cone the projectiles without an offset are spread randomly within
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Volley, meta = (ClampMin = "0"))
+	float ConeHalfAngle = 5.0f;
+
+	// Fixed yaw and pitch offsets in degrees from the aim for the first projectiles, the rest are spread within the cone
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Volley)
+	TArray<FVector2D> Offsets;
+
+	// Fraction of the weapon's damage each projectile deals
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Volley, meta = (ClampMin = "0"))
+	float DamageScale = 1.0f;
 };
 
 /**
@@ -278,7 +315,7 @@ public:
 struct FBulletData
 {
 	FBulletData() = default;
-	FBulletData(const UWeaponInfo& WeaponInfo) : DamageType(WeaponInfo.DamageType), TimedStatusEffectClass(WeaponInfo.TimedStatusEffectClass), TimedStatusEffectDuration(WeaponInfo.TimedStatusEffectDuration) {}
+	FBulletData(const UWeaponInfo& WeaponInfo) : DamageType(WeaponInfo.DamageType), TimedStatusEffectClass(WeaponInfo.TimedStatusEffectClass), TimedStatusEffectDuration(WeaponInfo.TimedStatusEffectDuration), WeaponId(WeaponInfo.GetPrimaryAssetId()) {}
 
 	// Damage to deal
 	int Damage = 0;
@@ -298,6 +335,12 @@ struct FBulletData
 	// Who shot us
 	TWeakObjectPtr<class ABaseCharacter> Shooter = nullptr;
 
-	// What shot us
+	// What shot us, not set when the weapon lives on the shooter
 	TWeakObjectPtr<class ABaseWeapon> Weapon = nullptr;
+
+	// Id of the weapon info that shot us
+	FPrimaryAssetId WeaponId = FPrimaryAssetId();
+
+	// How long before now the bullet should have been shot, in seconds. It's moved forward by this much when spawned
+	float TimeOffset = 0.0f;
 };
@@ -13,6 +13,8 @@
 #include "RC/Weapons/RCWeaponTypes.h"
 #include "RC/Weapons/Weapons/Components/WeaponComponent.h"
 
+const int32 ABaseWeapon::MaxShotsPerFrame = 16;
+
 ABaseWeapon::ABaseWeapon()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -61,6 +63,7 @@ void ABaseWeapon::InitWeaponComponent()
 	ASSERT(WeaponInfo != nullptr);
 	if (WeaponInfo != nullptr)
 	{
+		WeaponComponent->SetWeaponMesh(Mesh);
 		WeaponComponent->Init(*WeaponInfo);
 	}
 }
@@ -70,11 +73,25 @@ void ABaseWeapon::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (CooldownTimer.Elapsed())
+	// Fire every shot that came due since last frame, each as late as its cooldown elapsed within the frame
+	for (int32 ShotIndex = 0; ShotIndex < MaxShotsPerFrame && CooldownTimer.Elapsed(); ++ShotIndex)
 	{
+		FireTimeDebt = FMath::Clamp(-CooldownTimer.GetTimeRemaining(), 0.0f, DeltaTime);
+		if (WeaponComponent != nullptr)
+		{
+			WeaponComponent->SetShotTiming(FireTimeDebt, DeltaTime);
+		}
+
 		CooldownTimer.Invalidate();
 		CooldownEnded();
 	}
+	FireTimeDebt = 0;
+
+	if (WeaponComponent != nullptr)
+	{
+		WeaponComponent->SetShotTiming(0, DeltaTime);
+		WeaponComponent->RecordMuzzleTransform();
+	}
 }
 
 // Called when the weapon is being destroyed
@@ -84,21 +101,22 @@ void ABaseWeapon::EndPlay(const EEndPlayReason::Type Reason)
 
 	if (Reason == EEndPlayReason::Destroyed)
 	{
-		// Stop the attack montage if it's playing
-		if (bWielderAttackMontagePlaying)
-		{
-			if (WeaponInfo != nullptr)
-			{
-				if (Wielder != nullptr)
-				{
-					UAnimInstance* WielderAnimInstance = Wielder->GetAnimInstance();
-					if (WielderAnimInstance != nullptr)
-					{
-						WielderAnimInstance->Montage_Stop(0.2f, WeaponInfo->WeaponAttackMontage);
-					}
-				}
-			}
-		}
+		StopWielderAttackMontage();
+	}
+}
+
+// Stop the attack montage on the wielder if it's playing
+void ABaseWeapon::StopWielderAttackMontage()
+{
+	if (!bWielderAttackMontagePlaying || WeaponInfo == nullptr || Wielder == nullptr)
+	{
+		return;
+	}
+
+	UAnimInstance* WielderAnimInstance = Wielder->GetAnimInstance();
+	if (WielderAnimInstance != nullptr)
+	{
+		WielderAnimInstance->Montage_Stop(0.2f, WeaponInfo->WeaponAttackMontage);
 	}
 }
 
@@ -112,7 +130,7 @@ void ABaseWeapon::SetWielder(ABaseCharacter* NewWielder)
 	// Attach weapon to socket
 	if (!GetSocketName().IsNone())
 	{
-		USkeletalMeshComponent* WielderMesh = NewWielder->FindComponentByClass<USkeletalMeshComponent>();
+		USkeletalMeshComponent* WielderMesh = NewWielder->GetMesh();
 		if (WielderMesh)
 		{
 			FAttachmentTransformRules AttachmentRules = FAttachmentTransformRules::SnapToTargetNotIncludingScale;
@@ -158,6 +176,19 @@ bool ABaseWeapon::Attack()
 	return true;
 }
 
+// Stop any attack in progress and clear the cooldown
+void ABaseWeapon::ResetWeapon()
+{
+	bWielderAttackMontagePlaying = false;
+	bWeaponAttackMontagePlaying = false;
+	CooldownTimer.Invalidate();
+
+	if (WeaponInfo != nullptr)
+	{
+		CurrentCooldown = WeaponInfo->Cooldown;
+	}
+}
+
 // Perform an attack with the weapon
 void ABaseWeapon::PerformAttack()
 {
@@ -255,5 +286,7 @@ void ABaseWeapon::AttackEnded(bool bInterrupted)
 {
 	bWielderAttackMontagePlaying = false;
 	bWeaponAttackMontagePlaying = false;
-	CooldownTimer.Set(CurrentCooldown);
+
+	// Start the cooldown from when the shot was due rather than now
+	CooldownTimer.Set(CurrentCooldown - FireTimeDebt);
 }
@@ -42,6 +42,9 @@ public:
 	 */
 	bool Attack();
 
+	// Stop any attack in progress and clear the cooldown
+	virtual void ResetWeapon();
+
 	// Get the info for this weapon
 	UFUNCTION(BlueprintPure, Category = "Weapon|Info")
 	const UWeaponInfo* GetWeaponInfo() const { return WeaponInfo; }
@@ -88,6 +91,9 @@ protected:
 	// Called when the cooldown has ended
 	virtual void CooldownEnded() {};
 
+	// Stop the attack montage on the wielder if it's playing
+	void StopWielderAttackMontage();
+
 	// The current weapon config
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Config, meta = (AllowPrivateAccess = "true"))
 	UWeaponInfo* WeaponInfo;
@@ -116,6 +122,13 @@ protected:
 	// Whether the attack montage is playing on the weapon
 	bool bWeaponAttackMontagePlaying = false;
 
+	// How late the shot being fired is compared to when its cooldown elapsed, in seconds.
+	// Taken off of the next cooldown so the fire rate doesn't depend on the frame rate
+	float FireTimeDebt = 0;
+
+	// Most shots that can be fired in a single frame, to keep a hitch from firing a burst all at once
+	static const int32 MaxShotsPerFrame;
+
 private:
 	// Called when the anim notify attack is triggered
 	UFUNCTION(BlueprintCallable)
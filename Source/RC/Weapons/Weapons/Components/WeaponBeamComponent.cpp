@@ -0,0 +1,300 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "WeaponBeamComponent.h"
+
+#include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystemComponent.h"
+
+#include "RC/Characters/Player/RCCharacter.h"
+#include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageSubsystem.h"
+#include "RC/Util/RCStatics.h"
+
+UWeaponBeamComponent::UWeaponBeamComponent()
+{
+	// Only tick while the beam is on, after animation has moved the socket
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+// Initialize the weapon component
+void UWeaponBeamComponent::Init(const UWeaponInfo& InWeaponInfo)
+{
+	Super::Init(InWeaponInfo);
+
+	// Save off socket
+	ASSERT_RETURN(WeaponMesh != nullptr, "Weapon component on %s doesn't have a weapon mesh set", *GetOwner()->GetName());
+	{
+		const FName& SocketName = InWeaponInfo.SocketName;
+		if (!SocketName.IsNone())
+		{
+			BeamSocket = WeaponMesh->GetSocketByName(SocketName);
+		}
+	}
+}
+
+// Start the beam or keep it going
+bool UWeaponBeamComponent::Attack()
+{
+	KeepBeamActive(nullptr);
+	return true;
+}
+
+// Start the beam at the given target or keep it going
+bool UWeaponBeamComponent::AttackTarget(ABaseCharacter* Target)
+{
+	ASSERT_RETURN_VALUE(Target != nullptr, false);
+
+	KeepBeamActive(Target);
+	return true;
+}
+
+// Trace the beam and accumulate its damage
+void UWeaponBeamComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Tick may have been re-enabled by the weapon being equipped while the beam is off
+	if (!IsBeamActive())
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// Only count the part of the frame the beam was on for
+	const float BeamTime = FMath::Min(DeltaTime, BeamTimeRemaining);
+	UpdateBeam(BeamTime);
+
+	TimeSinceFlush += BeamTime;
+	if (TimeSinceFlush >= DamageInterval)
+	{
+		TimeSinceFlush = FMath::Min(TimeSinceFlush - DamageInterval, DamageInterval);
+		FlushDamage();
+	}
+
+	BeamTimeRemaining -= DeltaTime;
+	if (!IsBeamActive())
+	{
+		StopBeam();
+	}
+}
+
+// Get where the beam is fired from
+FTransform UWeaponBeamComponent::GetMuzzleTransform() const
+{
+	return BeamSocket != nullptr ? BeamSocket->GetSocketTransform(WeaponMesh) : Super::GetMuzzleTransform();
+}
+
+// Turn the beam off without dealing the damage built up
+void UWeaponBeamComponent::ResetWeapon()
+{
+	Super::ResetWeapon();
+
+	Targets.Reset();
+	StopBeam();
+}
+
+// Stop the beam when the component goes away
+void UWeaponBeamComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopBeam();
+
+	if (SpawnedBeamFX != nullptr)
+	{
+		SpawnedBeamFX->DestroyComponent();
+		SpawnedBeamFX = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// Keep the beam on for a little longer
+void UWeaponBeamComponent::KeepBeamActive(ABaseCharacter* Target)
+{
+	ASSERT_RETURN(WeaponInfo != nullptr);
+
+	AActor* Owner = GetOwner();
+	ASSERT_RETURN(Owner != nullptr);
+
+	BeamTarget = Target;
+
+	const bool bStarting = !IsBeamActive();
+	BeamTimeRemaining = WeaponInfo->Cooldown + BeamReleaseTime;
+	if (!bStarting)
+	{
+		return;
+	}
+
+	TimeSinceFlush = 0.0f;
+	TraceParams = FCollisionQueryParams(SCENE_QUERY_STAT(BeamTrace), false, Owner);
+	TraceParams.AddIgnoredActor(Wielder);
+
+	// The FX is only spawned the first time, after that its endpoints are moved each frame
+	if (BeamFX != nullptr)
+	{
+		if (SpawnedBeamFX == nullptr)
+		{
+			SpawnedBeamFX = UGameplayStatics::SpawnEmitterAttached(BeamFX, Owner->GetRootComponent(), NAME_None, FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, false);
+		}
+		else
+		{
+			SpawnedBeamFX->Activate(true);
+		}
+	}
+
+	// Place the beam now so it doesn't show at its old endpoints for a frame
+	UpdateBeam(0.0f);
+	SetComponentTickEnabled(true);
+}
+
+// Turn the beam off, dealing any damage still built up
+void UWeaponBeamComponent::StopBeam()
+{
+	FlushDamage(true);
+
+	BeamTimeRemaining = 0.0f;
+	BeamTarget.Reset();
+	Targets.Reset();
+
+	if (SpawnedBeamFX != nullptr)
+	{
+		SpawnedBeamFX->Deactivate();
+	}
+
+	SetComponentTickEnabled(false);
+}
+
+// Trace the beam and build up damage on everything it goes through
+void UWeaponBeamComponent::UpdateBeam(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	UDamageSubsystem* DamageSubsystem = World->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
+
+	// One sweep through everything along the beam. Object queries never block, so every hit comes back sorted by distance
+	const FVector Start = GetMuzzleTransform().GetLocation();
+	const FVector Direction = GetBeamDirection(Start);
+	TArray<FHitResult> Hits;
+	World->SweepMultiByObjectType(Hits, Start, Start + Direction * GetRange(), FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllObjects), FCollisionShape::MakeSphere(BeamRadius), TraceParams);
+
+	FVector BeamEnd = Start + Direction * GetRange();
+	const float FrameDamage = GetDamage() * DeltaTime;
+	TSet<AActor*, DefaultKeyFuncs<AActor*>, TInlineSetAllocator<8>> HitActors;
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		const UPrimitiveComponent* HitComponent = Hit.GetComponent();
+		if (HitActor == nullptr || HitComponent == nullptr)
+		{
+			continue;
+		}
+
+		// The beam stops at the first thing blocking the camera that it can't damage, other than what it starts inside of
+		if (!DamageSubsystem->IsDamageable(*HitActor))
+		{
+			if (!Hit.bStartPenetrating && HitComponent->GetCollisionResponseToChannel(ECC_Camera) == ECR_Block)
+			{
+				BeamEnd = Hit.Location;
+				break;
+			}
+			continue;
+		}
+
+		// Actors with multiple components in the beam only take damage once
+		bool bAlreadyHit = false;
+		HitActors.Add(HitActor, &bAlreadyHit);
+		if (bAlreadyHit)
+		{
+			continue;
+		}
+
+		FBeamTarget& Target = Targets.FindOrAdd(HitActor);
+		Target.Damage += FrameDamage;
+		Target.HitLocation = Hit.ImpactPoint;
+		Target.HitNormal = Hit.Normal;
+		Target.bHitSinceFlush = true;
+	}
+
+	if (SpawnedBeamFX != nullptr)
+	{
+		SpawnedBeamFX->SetVectorParameter(BeamSourceParameter, Start);
+		SpawnedBeamFX->SetVectorParameter(BeamTargetParameter, BeamEnd);
+	}
+}
+
+// Get the direction the beam should fire in
+FVector UWeaponBeamComponent::GetBeamDirection(const FVector& Start) const
+{
+	// Fire at the target if there is one
+	const ABaseCharacter* Target = BeamTarget.Get();
+	if (Target != nullptr)
+	{
+		const UCapsuleComponent* TargetCapsule = Target->GetCapsuleComponent();
+		const FVector TargetLocation = TargetCapsule != nullptr ? TargetCapsule->GetComponentLocation() : Target->GetActorLocation();
+		return (TargetLocation - Start).GetSafeNormal();
+	}
+
+	// Otherwise follow what the player's camera is aiming at
+	ARCCharacter* Player = Cast<ARCCharacter>(Wielder);
+	if (Player != nullptr && WielderCamera != nullptr)
+	{
+		// The range is for the weapon's range, so we need to add the distance from the camera to the wielder to the cast
+		const float AimDistance = GetRange() + FVector::Dist(WielderCamera->GetComponentLocation(), Wielder->GetActorLocation());
+		return (Player->GetAimTarget(AimDistance) - Start).GetSafeNormal();
+	}
+
+	const AActor* Owner = GetOwner();
+	return Owner != nullptr ? Owner->GetActorForwardVector() : FVector::ForwardVector;
+}
+
+// Deal the whole damage built up on each target, keeping the remainder for the next flush
+void UWeaponBeamComponent::FlushDamage(bool bFinal/* = false*/)
+{
+	if (Targets.Num() == 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	UDamageSubsystem* DamageSubsystem = World->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
+
+	FDamageRequestParams DamageParams;
+	DamageParams.bFromPlayer = URCStatics::IsActorPlayer(Wielder);
+	DamageParams.DamageType = WeaponInfo->DamageType;
+	DamageParams.Instigator = Wielder;
+	DamageParams.CauseId = WeaponInfoId;
+
+	for (auto Iter = Targets.CreateIterator(); Iter; ++Iter)
+	{
+		// Forget anything that's gone or has left the beam
+		AActor* Actor = Iter.Key().Get();
+		FBeamTarget& Target = Iter.Value();
+		if (Actor == nullptr || (!Target.bHitSinceFlush && !bFinal))
+		{
+			Iter.RemoveCurrent();
+			continue;
+		}
+		Target.bHitSinceFlush = false;
+
+		// The last flush rounds up so the remainder isn't lost when the beam stops
+		const int32 WholeDamage = bFinal ? FMath::CeilToInt(Target.Damage - KINDA_SMALL_NUMBER) : FMath::FloorToInt(Target.Damage);
+		if (WholeDamage <= 0)
+		{
+			continue;
+		}
+		Target.Damage -= WholeDamage;
+
+		DamageParams.Damage = WholeDamage;
+		DamageParams.HitLocation = Target.HitLocation;
+		DamageParams.HitNormal = Target.HitNormal;
+		DamageSubsystem->QueueDamage(*Actor, DamageParams, WeaponInfo->TimedStatusEffectClass, WeaponInfo->TimedStatusEffectDuration);
+	}
+}
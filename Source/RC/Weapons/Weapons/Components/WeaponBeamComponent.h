@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "RC/Weapons/Weapons/Components/WeaponComponent.h"
+
+#include "WeaponBeamComponent.generated.h"
+
+/**
+ * Weapon that fires a continuous beam through everything damageable in front of it.
+ * The beam stays on while the weapon keeps attacking. Its damage is the damage per second dealt to everything in it,
+ * accumulated every frame and dealt at a fixed interval so it doesn't depend on the frame rate
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class RC_API UWeaponBeamComponent : public UWeaponComponent
+{
+	GENERATED_BODY()
+
+public:
+	UWeaponBeamComponent();
+
+	// Initialize the weapon component
+	void Init(const UWeaponInfo& InWeaponInfo) override;
+
+	// Start the beam or keep it going
+	bool Attack() override;
+
+	// Start the beam at the given target or keep it going
+	bool AttackTarget(class ABaseCharacter* Target) override;
+
+	// Trace the beam and accumulate its damage
+	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Get where the beam is fired from
+	FTransform GetMuzzleTransform() const override;
+
+	// Turn the beam off without dealing the damage built up
+	void ResetWeapon() override;
+
+	// Whether the beam is on
+	UFUNCTION(BlueprintPure, Category = "Weapon")
+	bool IsBeamActive() const { return BeamTimeRemaining > 0; }
+
+protected:
+	// Stop the beam when the component goes away
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/**
+	 * Damage built up on an actor in the beam
+	 */
+	struct FBeamTarget
+	{
+		// Damage not yet dealt
+		float Damage = 0.0f;
+
+		// Where the beam last hit the actor
+		FVector HitLocation = FVector::ZeroVector;
+
+		// The normal of where the beam last hit the actor
+		FVector HitNormal = FVector::ZeroVector;
+
+		// Whether the actor was in the beam since the last flush
+		bool bHitSinceFlush = false;
+	};
+
+	/**
+	 * Keep the beam on for a little longer
+	 * @param Target	The character to keep the beam on, or null to follow the wielder's aim
+	 */
+	void KeepBeamActive(class ABaseCharacter* Target);
+
+	// Turn the beam off, dealing any damage still built up
+	void StopBeam();
+
+	/**
+	 * Trace the beam and build up damage on everything it goes through
+	 * @param DeltaTime	Time in seconds the beam was on this frame
+	 */
+	void UpdateBeam(float DeltaTime);
+
+	// Get the direction the beam should fire in
+	FVector GetBeamDirection(const FVector& Start) const;
+
+	/**
+	 * Deal the whole damage built up on each target, keeping the remainder for the next flush
+	 * @param bFinal	Whether the beam is stopping, dealing the remainder too
+	 */
+	void FlushDamage(bool bFinal = false);
+
+	// Seconds between dealing the built up damage
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	float DamageInterval = 0.25f;
+
+	// Radius of the beam
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	float BeamRadius = 10.0f;
+
+	// How long in seconds the beam stays on after the weapon's cooldown once it stops attacking
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
+	float BeamReleaseTime = 0.1f;
+
+	// FX of the beam
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Effect, meta = (AllowPrivateAccess = "true"))
+	class UParticleSystem* BeamFX = nullptr;
+
+	// Name of the FX's vector parameter for where the beam starts
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Effect, meta = (AllowPrivateAccess = "true"))
+	FName BeamSourceParameter = FName(TEXT("BeamSource"));
+
+	// Name of the FX's vector parameter for where the beam ends
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Effect, meta = (AllowPrivateAccess = "true"))
+	FName BeamTargetParameter = FName(TEXT("BeamTarget"));
+
+	// The beam FX, spawned once and reused every time the beam is fired
+	UPROPERTY(Transient)
+	class UParticleSystemComponent* SpawnedBeamFX = nullptr;
+
+	// The socket the beam is fired from
+	const class USkeletalMeshSocket* BeamSocket = nullptr;
+
+	// The character the beam is being fired at, if not following the wielder's aim
+	TWeakObjectPtr<class ABaseCharacter> BeamTarget;
+
+	// Damage built up on each actor in the beam
+	TMap<TWeakObjectPtr<AActor>, FBeamTarget> Targets;
+
+	// Params of the beam traces
+	FCollisionQueryParams TraceParams;
+
+	// Time in seconds until the beam turns off unless the weapon attacks again
+	float BeamTimeRemaining = 0.0f;
+
+	// Time in seconds since the built up damage was last dealt
+	float TimeSinceFlush = 0.0f;
+};
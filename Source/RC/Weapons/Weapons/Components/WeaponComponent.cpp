@@ -2,6 +2,7 @@
 #include "WeaponComponent.h"
 
 #include "Camera/CameraComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 
 #include "RC/Characters/BaseCharacter.h"
 
@@ -20,3 +21,86 @@ void UWeaponComponent::SetWielder(ABaseCharacter* NewWielder)
 	Wielder = NewWielder;
 	WielderCamera = NewWielder->FindComponentByClass<UCameraComponent>();
 }
+
+// Get where shots are fired from
+FTransform UWeaponComponent::GetMuzzleTransform() const
+{
+	return WeaponMesh != nullptr ? WeaponMesh->GetComponentTransform() : FTransform::Identity;
+}
+
+// Stop any attack in progress and forget pending traces and shot timing
+void UWeaponComponent::ResetWeapon()
+{
+	PendingTraces.Reset();
+	ShotTimeOffset = 0.0f;
+	FrameDeltaTime = 0.0f;
+	bHasLastFrameMuzzle = false;
+}
+
+// Remember where the muzzle is at the end of this frame
+void UWeaponComponent::RecordMuzzleTransform()
+{
+	LastFrameMuzzleTransform = GetMuzzleTransform();
+	bHasLastFrameMuzzle = true;
+}
+
+// Get where the muzzle was when the current shot should have been fired
+FTransform UWeaponComponent::GetShotMuzzleTransform() const
+{
+	const FTransform MuzzleTransform = GetMuzzleTransform();
+	if (!bHasLastFrameMuzzle || ShotTimeOffset <= 0 || FrameDeltaTime <= SMALL_NUMBER)
+	{
+		return MuzzleTransform;
+	}
+
+	// Blend back towards last frame by how far into the frame the shot was due
+	FTransform ShotTransform;
+	ShotTransform.Blend(LastFrameMuzzleTransform, MuzzleTransform, FMath::Clamp(1 - ShotTimeOffset / FrameDeltaTime, 0.0f, 1.0f));
+	return ShotTransform;
+}
+
+// Get the delegate to pass to async traces that are waited on with QueueAsyncTrace
+FTraceDelegate* UWeaponComponent::GetAsyncTraceDelegate()
+{
+	if (!AsyncTraceDelegate.IsBound())
+	{
+		AsyncTraceDelegate.BindUObject(this, &UWeaponComponent::OnAsyncTraceFinished);
+	}
+	return &AsyncTraceDelegate;
+}
+
+// Wait on an async trace
+void UWeaponComponent::QueueAsyncTrace(const FTraceHandle& Handle, FAsyncTraceResolver&& Resolver)
+{
+	FPendingTrace& PendingTrace = PendingTraces.AddDefaulted_GetRef();
+	PendingTrace.Handle = Handle;
+	PendingTrace.Resolver = MoveTemp(Resolver);
+}
+
+// Called when an async trace has finished
+void UWeaponComponent::OnAsyncTraceFinished(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	// Traces forgotten by a reset still finish, but nothing is waiting on them
+	FPendingTrace* PendingTrace = PendingTraces.FindByPredicate([&Handle](const FPendingTrace& Trace) { return Trace.Handle == Handle; });
+	if (PendingTrace == nullptr)
+	{
+		return;
+	}
+
+	PendingTrace->Hits = MoveTemp(Datum.OutHits);
+	PendingTrace->bFinished = true;
+
+	// Resolve everything that's ready in the order it was queued, stopping at the first trace still running
+	int32 NumResolved = 0;
+	while (NumResolved < PendingTraces.Num() && PendingTraces[NumResolved].bFinished)
+	{
+		// Copy out in case resolving queues another trace
+		FPendingTrace Resolved = MoveTemp(PendingTraces[NumResolved]);
+		++NumResolved;
+		if (Resolved.Resolver)
+		{
+			Resolved.Resolver(Resolved.Hits);
+		}
+	}
+	PendingTraces.RemoveAt(0, NumResolved);
+}
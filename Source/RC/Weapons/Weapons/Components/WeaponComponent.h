@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "Components/ActorComponent.h"
+#include "WorldCollision.h"
 
 #include "RC/Util/RCTypes.h"
 #include "RC/Util/TimeStamp.h"
@@ -28,6 +29,12 @@ public:
 	 */
 	void SetWielder(ABaseCharacter* NewWielder);
 
+	/**
+	 * Set the mesh the weapon fires from. Must be set before Init
+	 * @param InWeaponMesh	The mesh of the weapon, either on a weapon actor or on the wielder itself
+	 */
+	void SetWeaponMesh(const class USkeletalMeshComponent* InWeaponMesh) { WeaponMesh = InWeaponMesh; }
+
 	// Attack with the weapon
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Attack")
 	virtual bool Attack() { return true; }
@@ -50,6 +57,12 @@ public:
 	// Get the current range this weapon has
 	FORCEINLINE float GetRange() { return Range; }
 
+	// Get where shots are fired from
+	virtual FTransform GetMuzzleTransform() const;
+
+	// Stop any attack in progress and forget pending traces and shot timing, so the weapon starts fresh when reused
+	virtual void ResetWeapon();
+
 protected:
 	friend class ABaseWeapon;
 
@@ -62,6 +75,37 @@ protected:
 	// Called when the anim notify state attack ends
 	virtual void OnAnimNotifyStateAttack_End() {}
 
+	/**
+	 * Set when the shot about to be fired should have been fired, for weapons firing faster than the frame rate
+	 * @param InShotTimeOffset	How long before now the shot should have been fired, in seconds
+	 * @param InFrameDeltaTime	Length of the frame the shot is being fired in
+	 */
+	void SetShotTiming(float InShotTimeOffset, float InFrameDeltaTime) { ShotTimeOffset = InShotTimeOffset; FrameDeltaTime = InFrameDeltaTime; }
+
+	// Remember where the muzzle is at the end of this frame so shots fired during the next frame can be placed between the two
+	void RecordMuzzleTransform();
+
+	// Get where the muzzle was when the current shot should have been fired
+	FTransform GetShotMuzzleTransform() const;
+
+	// Called with the hits of a finished async trace
+	typedef TFunction<void(const TArray<FHitResult>& Hits)> FAsyncTraceResolver;
+
+	// Whether this weapon's traces should be async
+	bool UseAsyncTraces() const { return WeaponInfo != nullptr && WeaponInfo->bAsyncTraces; }
+
+	// Get the delegate to pass to async traces that are waited on with QueueAsyncTrace
+	FTraceDelegate* GetAsyncTraceDelegate();
+
+	/**
+	 * Wait on an async trace. Traces are resolved in the order they're queued,
+	 * so multiple shots in the same frame always resolve the same way
+	 *
+	 * @param Handle	The trace to wait on
+	 * @param Resolver	Called with the hits of the trace once it and every trace queued before it have finished
+	 */
+	void QueueAsyncTrace(const FTraceHandle& Handle, FAsyncTraceResolver&& Resolver);
+
 	// Damage this weapon does
 	UPROPERTY(BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
 	int Damage;
@@ -80,4 +124,51 @@ protected:
 
 	// Camera of the wielder of this weapon
 	class UCameraComponent* WielderCamera = nullptr;
+
+	// Reference to the mesh of the weapon
+	const class USkeletalMeshComponent* WeaponMesh = nullptr;
+
+	// How long before now the current shot should have been fired, in seconds
+	float ShotTimeOffset = 0.0f;
+
+	// Length of the frame the current shot is being fired in
+	float FrameDeltaTime = 0.0f;
+
+	// Where the muzzle was at the end of last frame
+	FTransform LastFrameMuzzleTransform = FTransform::Identity;
+
+	// Whether the muzzle has been recorded yet
+	bool bHasLastFrameMuzzle = false;
+
+private:
+	/**
+	 * Called when an async trace has finished
+	 * @param Handle	The trace that finished
+	 * @param Datum		The results of the trace
+	 */
+	void OnAsyncTraceFinished(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/**
+	 * An async trace waiting to be resolved
+	 */
+	struct FPendingTrace
+	{
+		// The trace being waited on
+		FTraceHandle Handle;
+
+		// Called with the hits once resolved
+		FAsyncTraceResolver Resolver;
+
+		// The hits of the trace once finished
+		TArray<FHitResult> Hits;
+
+		// Whether the trace has finished
+		bool bFinished = false;
+	};
+
+	// Async traces in the order they were queued
+	TArray<FPendingTrace> PendingTraces;
+
+	// Delegate for async traces to call when finished
+	FTraceDelegate AsyncTraceDelegate;
 };
@@ -2,18 +2,52 @@
 #include "WeaponMeleeComponent.h"
 
 #include "RC/Characters/BaseCharacter.h"
-#include "RC/Characters/Components/StatusEffectComponent.h"
 #include "RC/Debug/Debug.h"
-#include "RC/Framework/DamageInterface.h"
+#include "RC/Framework/DamageSubsystem.h"
 #include "RC/Util/RCStatics.h"
 
+const float UWeaponMeleeComponent::MaxSweepStepAngle = 30.0f;
+const int32 UWeaponMeleeComponent::MaxSweepSteps = 8;
+
+UWeaponMeleeComponent::UWeaponMeleeComponent()
+{
+	// Only tick during the swing, after animation has moved the capsule
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
 // Initialize the weapon component
 void UWeaponMeleeComponent::Init(const UWeaponInfo& InWeaponInfo, UCapsuleComponent& CapsuleComponent)
 {
 	Super::Init(InWeaponInfo);
 
 	Capsule = &CapsuleComponent;
-	Capsule->OnComponentBeginOverlap.AddDynamic(this, &UWeaponMeleeComponent::OnWeaponTriggerOverlap);
+}
+
+// Sweep the capsule from where it was last frame to where it is now
+void UWeaponMeleeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Tick may have been re-enabled by the weapon being equipped outside of a swing
+	if (!bSwinging)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	SweepSwing();
+}
+
+// End any swing in progress
+void UWeaponMeleeComponent::ResetWeapon()
+{
+	Super::ResetWeapon();
+
+	bSwinging = false;
+	SwingHitActors.Reset();
+	SetComponentTickEnabled(false);
 }
 
 // Called when the anim notify state attack begins
@@ -21,8 +55,17 @@ void UWeaponMeleeComponent::OnAnimNotifyStateAttack_Begin()
 {
 	ASSERT_RETURN(Capsule != nullptr);
 
-	GetOwner()->SetActorEnableCollision(true);
-	Capsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	// Start a new swing
+	SwingHitActors.Reset();
+	SweepParams = FCollisionQueryParams(SCENE_QUERY_STAT(MeleeSweep), false, GetOwner());
+	SweepParams.AddIgnoredActor(Wielder);
+
+	// Sweep in place to hit anything already inside the capsule
+	LastSweepTransform = Capsule->GetComponentTransform();
+	SweepSwing();
+
+	bSwinging = true;
+	SetComponentTickEnabled(true);
 }
 
 // Called when the anim notify state attack ends
@@ -30,36 +73,79 @@ void UWeaponMeleeComponent::OnAnimNotifyStateAttack_End()
 {
 	ASSERT_RETURN(Capsule != nullptr);
 
-	GetOwner()->SetActorEnableCollision(false);
-	Capsule->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	// Catch up to where the capsule ended
+	SweepSwing();
+
+	bSwinging = false;
+	SetComponentTickEnabled(false);
+	SwingHitActors.Reset();
 }
 
-// On actor overlapping with the weapon's trigger
-void UWeaponMeleeComponent::OnWeaponTriggerOverlap(UPrimitiveComponent*, AActor* OtherActor, UPrimitiveComponent*, int32, bool, const FHitResult& HitResult)
+// Sweep the capsule from where it was last swept to where it is now, damaging anything not yet hit this swing
+void UWeaponMeleeComponent::SweepSwing()
 {
-	IDamageInterface* DamageableActor = Cast<IDamageInterface>(OtherActor);
-	if (DamageableActor != nullptr)
+	ASSERT_RETURN(Capsule != nullptr);
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	const FTransform SweepTransform = Capsule->GetComponentTransform();
+	const FCollisionShape Shape = Capsule->GetCollisionShape();
+
+	// A sweep can't rotate, so follow large arcs in steps
+	const float SweepAngle = FMath::RadiansToDegrees(LastSweepTransform.GetRotation().AngularDistance(SweepTransform.GetRotation()));
+	const int32 NumSteps = FMath::Clamp(FMath::CeilToInt(SweepAngle / MaxSweepStepAngle), 1, MaxSweepSteps);
+
+	TArray<FHitResult> Hits;
+	FTransform StepStart = LastSweepTransform;
+	for (int32 Step = 1; Step <= NumSteps; ++Step)
 	{
-		// Request damage on hit
-		FDamageRequestParams DamageParams;
-		DamageParams.bFromPlayer = URCStatics::IsActorPlayer(Wielder);
-		DamageParams.Damage = Damage;
-		DamageParams.DamageType = WeaponInfo->DamageType;
-		DamageParams.Instigator = Wielder;
-		DamageParams.CauseId = WeaponInfoId;
-		DamageParams.HitLocation = HitResult.ImpactPoint;
-		DamageParams.HitNormal = HitResult.Normal;
-		DamageableActor->RequestDamage(DamageParams);
-
-		// Give status effect
-		if (WeaponInfo->TimedStatusEffectClass != NULL)
+		FTransform StepEnd;
+		StepEnd.Blend(LastSweepTransform, SweepTransform, static_cast<float>(Step) / NumSteps);
+
+		World->SweepMultiByProfile(Hits, StepStart.GetLocation(), StepEnd.GetLocation(), StepEnd.GetRotation(), URCStatics::OverlapOnlyActor_ProfileName, Shape, SweepParams);
+		for (const FHitResult& Hit : Hits)
 		{
-			UStatusEffectComponent* StatusEffectComponent = OtherActor->FindComponentByClass<UStatusEffectComponent>();
-			if (StatusEffectComponent != nullptr)
-			{
-				FStatusEffectTimedRequest TimedRequest(WeaponInfo->TimedStatusEffectClass, WeaponInfo->TimedStatusEffectDuration);
-				StatusEffectComponent->AddStatusEffectTimed(TimedRequest);
-			}
+			DamageHit(Hit);
 		}
-	}	
+
+		StepStart = StepEnd;
+	}
+
+	LastSweepTransform = SweepTransform;
+}
+
+// Damage an actor hit by the swing
+void UWeaponMeleeComponent::DamageHit(const FHitResult& Hit)
+{
+	AActor* HitActor = Hit.GetActor();
+	if (HitActor == nullptr)
+	{
+		return;
+	}
+
+	// Each actor is only hit once a swing
+	bool bAlreadyHit = false;
+	SwingHitActors.Add(HitActor, &bAlreadyHit);
+	if (bAlreadyHit)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	UDamageSubsystem* DamageSubsystem = World->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
+
+	// Request damage on hit and give status effect
+	FDamageRequestParams DamageParams;
+	DamageParams.bFromPlayer = URCStatics::IsActorPlayer(Wielder);
+	DamageParams.Damage = Damage;
+	DamageParams.DamageType = WeaponInfo->DamageType;
+	DamageParams.Instigator = Wielder;
+	DamageParams.CauseId = WeaponInfoId;
+	DamageParams.HitLocation = Hit.ImpactPoint;
+	DamageParams.HitNormal = Hit.Normal;
+	DamageSubsystem->QueueDamage(*HitActor, DamageParams, WeaponInfo->TimedStatusEffectClass, WeaponInfo->TimedStatusEffectDuration);
 }
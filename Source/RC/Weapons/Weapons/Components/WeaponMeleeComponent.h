@@ -20,11 +20,19 @@ class RC_API UWeaponMeleeComponent : public UWeaponComponent
 	GENERATED_BODY()
 	
 public:
+	UWeaponMeleeComponent();
+
 	using UWeaponComponent::Init;
 
 	// Initialize the weapon component
 	void Init(const UWeaponInfo& InWeaponInfo, UCapsuleComponent& CapsuleComponent);
 
+	// Sweep the capsule from where it was last frame to where it is now
+	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// End any swing in progress
+	void ResetWeapon() override;
+
 protected:
 	// Called when the anim notify state attack begins
 	void OnAnimNotifyStateAttack_Begin() override;
@@ -32,9 +40,34 @@ protected:
 	// Called when the anim notify state attack ends
 	void OnAnimNotifyStateAttack_End() override;
 
-	// On actor overlapping with the weapon's trigger
-	UFUNCTION()
-	void OnWeaponTriggerOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	// Sweep the capsule from where it was last swept to where it is now, damaging anything not yet hit this swing
+	void SweepSwing();
 
+	/**
+	 * Damage an actor hit by the swing
+	 * @param Hit	The hit of the actor
+	 */
+	void DamageHit(const FHitResult& Hit);
+
+	// The capsule swept through the swing. Only its shape and transform are used, it never has collision itself
 	UCapsuleComponent* Capsule = nullptr;
+
+private:
+	// The largest rotation in degrees the capsule can make between sweeps before the sweep is broken into steps to follow the arc
+	static const float MaxSweepStepAngle;
+
+	// The most steps a single sweep can be broken into
+	static const int32 MaxSweepSteps;
+
+	// Actors already hit this swing
+	TSet<TWeakObjectPtr<AActor>> SwingHitActors;
+
+	// Params of the sweeps this swing
+	FCollisionQueryParams SweepParams;
+
+	// Where the capsule was at the last sweep
+	FTransform LastSweepTransform = FTransform::Identity;
+
+	// Whether the attack notify window is open
+	bool bSwinging = false;
 };
@@ -3,13 +3,18 @@
 
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SphereComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 
 #include "RC/Characters/Player/RCCharacter.h"
 #include "RC/Debug/Debug.h"
+#include "RC/Framework/RCActorPoolSubsystem.h"
 #include "RC/Util/RCTypes.h"
 #include "RC/Weapons/Bullets/BaseBullet.h"
+#include "RC/Weapons/Bullets/ProjectileSubsystem.h"
 #include "RC/Weapons/Weapons/BaseWeapon.h"
+#include "RC/Weapons/Weapons/TrajectoryPreview.h"
 
 void UWeaponProjectileComponent::Init(const UWeaponInfo& InWeaponInfo)
 {
@@ -18,13 +23,9 @@ void UWeaponProjectileComponent::Init(const UWeaponInfo& InWeaponInfo)
 	Accuracy = InWeaponInfo.BaseAccuracy;
 
 	// Save off socket
-	const ABaseWeapon* Owner = GetOwner<ABaseWeapon>();
-	ASSERT_RETURN(Owner != nullptr, "Weapon component placed on %s. It needs to inherit from ABaseWeapon", *GetOwner()->GetName());
-
-	WeaponMesh = Owner->GetMesh();
-	if (WeaponMesh != nullptr)
+	ASSERT_RETURN(WeaponMesh != nullptr, "Weapon component on %s doesn't have a weapon mesh set", *GetOwner()->GetName());
 	{
-		const FName& SocketName = Owner->GetSocketName();
+		const FName& SocketName = InWeaponInfo.SocketName;
 		if (!SocketName.IsNone())
 		{
 			BulletOffsetSocket = WeaponMesh->GetSocketByName(SocketName);
@@ -41,23 +42,13 @@ bool UWeaponProjectileComponent::Attack()
 	AActor* Owner = GetOwner();
 	ASSERT_RETURN_VALUE(Owner != nullptr, false);
 
-	UWorld* World = GetWorld();
-	ASSERT_RETURN_VALUE(World != nullptr, false);
-
-	// Get the target
+	// Get the target from what the player's camera is aiming at
 	FVector Target;
-	if (WielderCamera != nullptr)
+	ARCCharacter* Player = Cast<ARCCharacter>(Wielder);
+	if (Player != nullptr && WielderCamera != nullptr)
 	{
-		FCollisionQueryParams RV_TraceParams = FCollisionQueryParams(FName(TEXT("Gun Trace")), true, Owner);
-		RV_TraceParams.bReturnPhysicalMaterial = false;
-		RV_TraceParams.AddIgnoredActor(static_cast<AActor*>(Wielder));
-
-		FHitResult Hit(EForceInit::ForceInit);
-		FVector Start = WielderCamera->GetComponentLocation();
-		FVector End = Start + (WielderCamera->GetComponentRotation().Vector() * GetRange());
-		World->LineTraceSingleByChannel(Hit, Start, End, ECC_Camera, RV_TraceParams);
-
-		Target = Hit.bBlockingHit ? Hit.ImpactPoint : End;
+		// The player's aim trace is shared and only done once a frame. Async weapons use the last async one so they never trace on the game thread
+		Target = UseAsyncTraces() ? Player->GetAsyncAimTarget(GetRange()) : Player->GetAimTarget(GetRange());
 	}
 	else
 	{
@@ -67,50 +58,59 @@ bool UWeaponProjectileComponent::Attack()
 	return ShootAtTarget(Target);
 }
 
-// Attack with the weapon at the given target
-bool UWeaponProjectileComponent::AttackTarget(ABaseCharacter* Target)
+// Get where bullets are shot from
+FTransform UWeaponProjectileComponent::GetMuzzleTransform() const
 {
-	return ShootAtTarget(Target);
+	return GetBulletOffsetSocket() != nullptr ? GetBulletOffsetSocket()->GetSocketTransform(WeaponMesh) : Super::GetMuzzleTransform();
 }
 
-// Shoot the weapon at the specified target
-bool UWeaponProjectileComponent::ShootAtTarget(const FVector& TargetLocation)
+// Update the predicted arc of a bullet if it were shot now
+bool UWeaponProjectileComponent::UpdateTrajectoryPreview(FTrajectoryPreview& Preview)
 {
-	ASSERT_RETURN_VALUE(GetBulletOffsetSocket() != nullptr, false);
-
-	ABaseWeapon* Weapon = GetOwner<ABaseWeapon>();
-	ASSERT_RETURN_VALUE(Weapon != nullptr, false, "Weapon component placed on %s. It needs to inherit from ABaseWeapon", *GetOwner()->GetName());
+	AActor* Owner = GetOwner();
+	ASSERT_RETURN_VALUE(Owner != nullptr, false);
 
 	UWorld* World = GetWorld();
 	ASSERT_RETURN_VALUE(World != nullptr, false);
 
-	// Spawn the bullet at the offset
-	const FTransform& BulletTransform = GetBulletOffsetSocket()->GetSocketTransform(WeaponMesh);
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = Weapon;
-	SpawnParams.Instigator = static_cast<APawn*>(Wielder);
-	SpawnParams.bNoFail = true;
-	ABaseBullet* Bullet = World->SpawnActor<ABaseBullet>(ProjectileClass, BulletTransform, SpawnParams);
-	ASSERT_RETURN_VALUE(Bullet != nullptr, false);
+	const ABaseBullet* DefaultBullet = ProjectileClass != nullptr ? ProjectileClass->GetDefaultObject<ABaseBullet>() : nullptr;
+	ASSERT_RETURN_VALUE(DefaultBullet != nullptr, false);
+	const USphereComponent* Collision = DefaultBullet->GetCollision();
+	const UProjectileMovementComponent* Movement = DefaultBullet->GetMovement();
+	ASSERT_RETURN_VALUE(Collision != nullptr && Movement != nullptr, false, "Bullet %s is missing a component", *ProjectileClass->GetName());
 
-	FVector Trajectory = TargetLocation - BulletTransform.GetLocation();
-	Trajectory.Normalize();
+	// Aim the same way a shot would
+	const FTransform MuzzleTransform = GetMuzzleTransform();
+	ARCCharacter* Player = Cast<ARCCharacter>(Wielder);
+	const FVector Target = Player != nullptr ? Player->GetAimTarget(GetRange()) : Owner->GetActorLocation() + Owner->GetActorForwardVector();
+	const FVector Direction = (Target - MuzzleTransform.GetLocation()).GetSafeNormal();
 
-	// Accuracy offset
-	if (!FMath::IsNearlyEqual(Accuracy, 1))
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(TrajectoryPreview), false, Owner);
+	Params.AddIgnoredActor(Wielder);
+
+	Preview.Update(*World, MuzzleTransform.GetLocation(), Direction * Movement->InitialSpeed, World->GetGravityZ() * Movement->ProjectileGravityScale,
+		Collision->GetScaledSphereRadius(), Collision->GetCollisionObjectType(), Params, FCollisionResponseParams(Collision->GetCollisionResponseToChannels()));
+	return true;
+}
+
+// Attack with the weapon at the given target
+bool UWeaponProjectileComponent::AttackTarget(ABaseCharacter* Target)
+{
+	return ShootAtTarget(Target);
+}
+
+// Shoot the weapon at the specified target
+bool UWeaponProjectileComponent::ShootAtTarget(const FVector& TargetLocation)
+{
+	if (Volley != nullptr)
 	{
-		Trajectory = FMath::VRandCone(Trajectory, FMath::DegreesToRadians(25 * (1 - Accuracy)));
+		return ShootVolley(*Volley, TargetLocation);
 	}
 
-	// Initialize bullet to send it off
-	FBulletData BulletData(*WeaponInfo);
-	BulletData.Damage = GetDamage();
-	BulletData.Direction = Trajectory;
-	BulletData.Shooter = Wielder;
-	BulletData.Weapon = Weapon;
-
-	Bullet->Init(BulletData);
-	return true;
+	// A single projectile straight along the aim
+	const FTransform BulletTransform = GetShotMuzzleTransform();
+	const FVector Direction = GetShotAim(BulletTransform.GetLocation(), TargetLocation);
+	return ShootProjectiles(BulletTransform, GetDamage(), MakeArrayView(&Direction, 1));
 }
 
 // Shoot the weapon at the specified target
@@ -134,3 +134,99 @@ bool UWeaponProjectileComponent::ShootAtTarget(ABaseCharacter* Target)
 	}
 	return ShootAtTarget(TargetLocation);
 }
+
+// Shoot every projectile of a volley at once towards a target
+bool UWeaponProjectileComponent::ShootVolley(const UVolleyInfo& InVolley, const FVector& TargetLocation)
+{
+	ASSERT_RETURN_VALUE(InVolley.Count > 0, false);
+
+	// Everything the projectiles share is worked out once for the whole volley
+	const FTransform BulletTransform = GetShotMuzzleTransform();
+	const FVector Aim = GetShotAim(BulletTransform.GetLocation(), TargetLocation);
+	const FQuat AimRotation = Aim.ToOrientationQuat();
+	const FVector Right = AimRotation.GetRightVector();
+
+	const int32 Count = InVolley.Count;
+	TArray<FVector, TInlineAllocator<16>> Directions;
+	Directions.SetNumUninitialized(Count);
+
+	// Offsets are relative to the aim, with yaw to the right and pitch upwards
+	const int32 NumOffsets = FMath::Min(Count, InVolley.Offsets.Num());
+	for (int32 Index = 0; Index < NumOffsets; ++Index)
+	{
+		const FVector2D& Offset = InVolley.Offsets[Index];
+		Directions[Index] = AimRotation.RotateVector(FRotator(Offset.Y, Offset.X, 0.0f).Vector());
+	}
+
+	// The rest are spread evenly over the solid angle of the cone, tilted away from the aim then rolled around it
+	const float MinConeCos = FMath::Cos(FMath::DegreesToRadians(InVolley.ConeHalfAngle));
+	for (int32 Index = NumOffsets; Index < Count; ++Index)
+	{
+		const float Angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Lerp(1.0f, MinConeCos, FMath::FRand())));
+		const float Roll = FMath::FRand() * 360.0f;
+		Directions[Index] = Aim.RotateAngleAxis(Angle, Right).RotateAngleAxis(Roll, Aim);
+	}
+
+	const int32 Damage = FMath::Max(FMath::RoundToInt(GetDamage() * InVolley.DamageScale), 1);
+	return ShootProjectiles(BulletTransform, Damage, Directions);
+}
+
+// Get the direction to aim a shot in, with the weapon's accuracy applied
+FVector UWeaponProjectileComponent::GetShotAim(const FVector& Start, const FVector& TargetLocation) const
+{
+	FVector Aim = (TargetLocation - Start).GetSafeNormal();
+
+	// Accuracy offset
+	if (!FMath::IsNearlyEqual(Accuracy, 1))
+	{
+		Aim = FMath::VRandCone(Aim, FMath::DegreesToRadians(25 * (1 - Accuracy)));
+	}
+	return Aim;
+}
+
+// Shoot a projectile in each direction from the muzzle
+bool UWeaponProjectileComponent::ShootProjectiles(const FTransform& BulletTransform, int32 Damage, TArrayView<const FVector> Directions)
+{
+	ASSERT_RETURN_VALUE(GetBulletOffsetSocket() != nullptr, false);
+	ASSERT_RETURN_VALUE(Directions.Num() != 0, false);
+
+	// Either the weapon actor or the wielder itself when the weapon lives on them
+	AActor* Owner = GetOwner();
+	ASSERT_RETURN_VALUE(Owner != nullptr, false);
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN_VALUE(World != nullptr, false);
+
+	// Initialize bullet to send it off
+	FBulletData BulletData(*WeaponInfo);
+	BulletData.Damage = Damage;
+	BulletData.Direction = Directions[0];
+	BulletData.Shooter = Wielder;
+	BulletData.Weapon = Cast<ABaseWeapon>(Owner);
+	BulletData.TimeOffset = ShotTimeOffset;
+
+	// Let the projectile subsystem simulate them all in one go if the bullet supports it
+	const ABaseBullet* DefaultBullet = ProjectileClass != nullptr ? ProjectileClass->GetDefaultObject<ABaseBullet>() : nullptr;
+	if (DefaultBullet != nullptr && DefaultBullet->IsBatchSimulated())
+	{
+		UProjectileSubsystem* ProjectileSubsystem = World->GetSubsystem<UProjectileSubsystem>();
+		ASSERT_RETURN_VALUE(ProjectileSubsystem != nullptr, false);
+		return ProjectileSubsystem->SpawnProjectiles(ProjectileClass, BulletTransform, BulletData, Directions, Owner);
+	}
+
+	URCActorPoolSubsystem* ActorPool = World->GetSubsystem<URCActorPoolSubsystem>();
+	ASSERT_RETURN_VALUE(ActorPool != nullptr, false);
+
+	// Spawn the bullets at the offset
+	bool bShotAny = false;
+	for (const FVector& Direction : Directions)
+	{
+		ABaseBullet* Bullet = Cast<ABaseBullet>(ActorPool->AcquireActor(ProjectileClass, BulletTransform, Owner, static_cast<APawn*>(Wielder)));
+		ASSERT_CONTINUE(Bullet != nullptr);
+
+		BulletData.Direction = Direction;
+		Bullet->Init(BulletData);
+		bShotAny = true;
+	}
+	return bShotAny;
+}
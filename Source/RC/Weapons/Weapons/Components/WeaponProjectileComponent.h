@@ -25,11 +25,29 @@ public:
 
 	void SetAccuracy(float InAccuracy) { Accuracy = InAccuracy; }
 
+	// Get where bullets are shot from
+	FTransform GetMuzzleTransform() const override;
+
+	/**
+	 * Update the predicted arc of a bullet if it were shot now
+	 * @param Preview	The preview to update
+	 * Returns false if the arc couldn't be predicted
+	 */
+	bool UpdateTrajectoryPreview(class FTrajectoryPreview& Preview);
+
+	/**
+	 * Shoot every projectile of a volley at once towards a target
+	 * @param InVolley			The pattern of the projectiles
+	 * @param TargetLocation	The location the volley is aimed at
+	 * Returns true if the volley was shot
+	 */
+	bool ShootVolley(const UVolleyInfo& InVolley, const FVector& TargetLocation);
+
 	// Returns Mesh subobject
 	FORCEINLINE const class USkeletalMeshSocket* GetBulletOffsetSocket() const { return BulletOffsetSocket; }
 
 protected:
-	/** Shoot the weapon at the specified target
+	/** Shoot the weapon at the specified target, as a volley if the weapon has one
 	 * @param TargetLocation	The location to shoot at
 	 */
 	virtual bool ShootAtTarget(const FVector& TargetLocation);
@@ -40,6 +58,22 @@ protected:
 	virtual bool ShootAtTarget(class ABaseCharacter* Target);
 
 private:
+	/**
+	 * Get the direction to aim a shot in, with the weapon's accuracy applied
+	 * @param Start				Where the shot starts
+	 * @param TargetLocation	The location the shot is aimed at
+	 */
+	FVector GetShotAim(const FVector& Start, const FVector& TargetLocation) const;
+
+	/**
+	 * Shoot a projectile in each direction from the muzzle
+	 * @param BulletTransform	Where the projectiles start
+	 * @param Damage			The damage each projectile deals
+	 * @param Directions		The normalized direction of each projectile
+	 * Returns true if any projectile was shot
+	 */
+	bool ShootProjectiles(const FTransform& BulletTransform, int32 Damage, TArrayView<const FVector> Directions);
+
 	// The socket where the bullet should spawn from
 	const class USkeletalMeshSocket* BulletOffsetSocket = nullptr;
 
@@ -47,7 +81,9 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile, Meta=(AllowPrivateAccess="True"))
 	TSubclassOf<class ABaseBullet> ProjectileClass;
 
-	const class USkeletalMeshComponent* WeaponMesh = nullptr;
+	// The volley shot with every attack, a single projectile is shot if not set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile, Meta = (AllowPrivateAccess = "True"))
+	class UVolleyInfo* Volley = nullptr;
 
 	float Accuracy = 1;
 };
@@ -5,28 +5,27 @@
 #include "Components/CapsuleComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
 
-#include "RC/Characters/Components/StatusEffectComponent.h"
 #include "RC/Characters/Player/RCCharacter.h"
 #include "RC/Debug/Debug.h"
+#include "RC/Framework/DamageSubsystem.h"
+#include "RC/Framework/RCActorPoolSubsystem.h"
 #include "RC/Util/RCStatics.h"
 #include "RC/Util/RCTypes.h"
 #include "RC/Weapons/Bullets/BaseBullet.h"
 #include "RC/Weapons/Weapons/BaseWeapon.h"
 
+const float UWeaponRaycastComponent::CloseTraceRangeFraction = 0.3f;
+const int32 UWeaponRaycastComponent::MaxOcclusionTraces = 8;
+
 // Initialize the weapon component
 void UWeaponRaycastComponent::Init(const UWeaponInfo& InWeaponInfo)
 {
 	Super::Init(InWeaponInfo);
 
 	// Save off socket
-	const ABaseWeapon* Owner = GetOwner<ABaseWeapon>();
-	ASSERT_RETURN(Owner != nullptr, "Weapon component placed on %s. It needs to inherit from ABaseWeapon", *GetOwner()->GetName());
-
-	WeaponMesh = Owner->GetMesh();
-
-	if (WeaponMesh != nullptr)
+	ASSERT_RETURN(WeaponMesh != nullptr, "Weapon component on %s doesn't have a weapon mesh set", *GetOwner()->GetName());
 	{
-		const FName& SocketName = Owner->GetSocketName();
+		const FName& SocketName = InWeaponInfo.SocketName;
 		if (!SocketName.IsNone())
 		{
 			VFXOffsetSocket = WeaponMesh->GetSocketByName(SocketName);
@@ -43,25 +42,19 @@ bool UWeaponRaycastComponent::Attack()
 	AActor* Owner = GetOwner();
 	ASSERT_RETURN_VALUE(Owner != nullptr, false);
 
-	UWorld* World = GetWorld();
-	ASSERT_RETURN_VALUE(World != nullptr, false);
-
 	// If the camera is aiming at something, shoot towards that
 	FVector TargetDirection;
-	if (WielderCamera != nullptr)
+	ARCCharacter* Player = Cast<ARCCharacter>(Wielder);
+	if (Player != nullptr && WielderCamera != nullptr)
 	{
-		FCollisionQueryParams RV_TraceParams = FCollisionQueryParams(FName(TEXT("Gun Trace")), true, Owner);
-		RV_TraceParams.bReturnPhysicalMaterial = false;
-		RV_TraceParams.AddIgnoredActor(static_cast<AActor*>(Wielder));
-
-		FHitResult Hit(EForceInit::ForceInit);
-		FVector Start = WielderCamera->GetComponentLocation();
+		const FVector Start = WielderCamera->GetComponentLocation();
 		// The range is for the weapon's range, so we need to add the distance from the camera to the wielder to the cast
-		FVector End = Start + WielderCamera->GetComponentRotation().Vector() * (GetRange() + (FVector::Dist(Start, Wielder->GetActorLocation())));
-		World->LineTraceSingleByChannel(Hit, Start, End, ECC_Camera, RV_TraceParams);
+		const float AimDistance = GetRange() + FVector::Dist(Start, Wielder->GetActorLocation());
+
+		// The player's aim trace is shared and only done once a frame. Async weapons use the last async one so they never trace on the game thread
+		TargetDirection = UseAsyncTraces() ? Player->GetAsyncAimTarget(AimDistance) : Player->GetAimTarget(AimDistance);
 
 		// Either go to what we hit or the end of the cast
-		TargetDirection = Hit.bBlockingHit ? Hit.ImpactPoint : End;
 		TargetDirection -= GetVFXOffsetSocket()->GetSocketTransform(WeaponMesh).GetLocation();
 		TargetDirection.Normalize();
 	}
@@ -103,8 +96,9 @@ bool UWeaponRaycastComponent::ShootTowardsTarget(const FVector& TargetDirection)
 {
 	LOG_CHECK(TargetDirection.IsNormalized(), LogWeapon, Warning, "Target direction isn't normalized");
 
-	ABaseWeapon* Weapon = GetOwner<ABaseWeapon>();
-	ASSERT_RETURN_VALUE(Weapon != nullptr, false, "Weapon component placed on %s. It needs to inherit from ABaseWeapon", *GetOwner()->GetName());
+	// Either the weapon actor or the wielder itself when the weapon lives on them
+	AActor* Weapon = GetOwner();
+	ASSERT_RETURN_VALUE(Weapon != nullptr, false);
 
 	UWorld* World = GetWorld();
 	ASSERT_RETURN_VALUE(World != nullptr, false);
@@ -112,95 +106,169 @@ bool UWeaponRaycastComponent::ShootTowardsTarget(const FVector& TargetDirection)
 	FTransform VFXTransform = GetVFXOffsetSocket()->GetSocketTransform(WeaponMesh);
 	VFXTransform.SetRotation(TargetDirection.ToOrientationQuat());
 
-	// Find actors in close range
-	FCollisionQueryParams TraceParams = FCollisionQueryParams(FName(TEXT("Gun Trace")), true, Weapon);
+	// One sweep wide enough for both the close and far shapes. Hits come back sorted by distance
+	const FCollisionQueryParams TraceParams = MakeTraceParams();
+	const FQuat TraceRotation = VFXTransform.GetRotation();
+	const FVector Start = VFXTransform.GetLocation();
+	const FVector End = Start + (TargetDirection * GetRange());
+	const FVector SweepHalfSize = CloseTraceHalfSize.ComponentMax(FarTraceHalfSize);
+
+	if (UseAsyncTraces())
+	{
+		// Once the sweep comes back, the line of sight to each target is traced async too before it's damaged
+		FTraceHandle Handle = World->AsyncSweepByProfile(EAsyncTraceType::Multi, Start, End, TraceRotation, URCStatics::OverlapOnlyActor_ProfileName, FCollisionShape::MakeBox(SweepHalfSize), TraceParams, GetAsyncTraceDelegate());
+		QueueAsyncTrace(Handle, [this, Start, TraceRotation](const TArray<FHitResult>& Hits)
+		{
+			QueueVisibleTargetTraces(Hits, Start, TraceRotation);
+		});
+	}
+	else
+	{
+		TArray<FHitResult> Hits;
+		World->SweepMultiByProfile(Hits, Start, End, TraceRotation, URCStatics::OverlapOnlyActor_ProfileName, FCollisionShape::MakeBox(SweepHalfSize), TraceParams);
+		DamageVisibleTargets(Hits, Start, TraceRotation);
+	}
+
+	// Spawn the VFX at the offset
+	URCActorPoolSubsystem* ActorPool = World->GetSubsystem<URCActorPoolSubsystem>();
+	if (VFXClass != nullptr && ActorPool != nullptr)
+	{
+		ActorPool->AcquireActor(VFXClass, VFXTransform, Weapon, static_cast<APawn*>(Wielder));
+	}
+
+	return true;
+}
+
+// Get the query params for the shot's traces, ignoring the weapon and its wielder
+FCollisionQueryParams UWeaponRaycastComponent::MakeTraceParams() const
+{
+	FCollisionQueryParams TraceParams = FCollisionQueryParams(FName(TEXT("Gun Trace")), true, GetOwner());
 	TraceParams.bReturnPhysicalMaterial = false;
 	TraceParams.AddIgnoredActor(static_cast<AActor*>(Wielder));
+	return TraceParams;
+}
 
-	TArray<FHitResult> Hits;
-	FVector Start = VFXTransform.GetLocation();
-	FVector End = Start + (TargetDirection * GetRange() * .3f);
-	bool bHit = World->SweepMultiByProfile(Hits, Start, End, VFXTransform.GetRotation(), FName("OverlapOnlyActor"), FCollisionShape::MakeBox(CloseTraceHalfSize), TraceParams);
-
-	// Find actors in far range
-	TArray<FHitResult> FarHits;
-	FVector FarEnd = End + (TargetDirection * GetRange() * .7f);
-	bool bFarHit = World->SweepMultiByProfile(FarHits, End, FarEnd, VFXTransform.GetRotation(), FName("OverlapOnlyActor"), FCollisionShape::MakeBox(FarTraceHalfSize), TraceParams);
+// Find the unique damageable actors within the close or far shape of a sweep
+void UWeaponRaycastComponent::FindTargets(const TArray<FHitResult>& Hits, const FVector& Start, const FQuat& TraceRotation, TArray<FHitResult>& OutTargets)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
 
-	// Setup damage params
-	FDamageRequestParams DamageParams;
-	DamageParams.bFromPlayer = URCStatics::IsActorPlayer(Wielder);
-	DamageParams.Damage = GetDamage();
-	DamageParams.DamageType = WeaponInfo->DamageType;
-	DamageParams.Instigator = Wielder;
-	DamageParams.CauseId = WeaponInfoId;
+	UDamageSubsystem* DamageSubsystem = World->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
 
-	FHitResult BlockedHit;
-	FCollisionQueryParams BlockedTraceParams = FCollisionQueryParams(FName(TEXT("Block Trace")), true, Weapon);
-	BlockedTraceParams.bReturnPhysicalMaterial = false;
-	BlockedTraceParams.AddIgnoredActor(static_cast<AActor*>(Wielder));
+	const float CloseRange = GetRange() * CloseTraceRangeFraction;
 
-	TArray<AActor*> HitActors;
-	// Damage the unique actors found in the raycasts
-	auto DamageHitActors = [&](const TArray<FHitResult>& Hits)
+	for (const FHitResult& Hit : Hits)
 	{
-		for (const FHitResult& Hit : Hits)
+		// Only check line of sight to the closest targets
+		if (OutTargets.Num() >= MaxOcclusionTraces)
 		{
-			AActor* HitActor = Hit.GetActor();
-			// Already damaged this actor
-			if (HitActors.Contains(HitActor))
-			{
-				continue;
-			}
+			break;
+		}
+
+		AActor* HitActor = Hit.GetActor();
+		if (HitActor == nullptr)
+		{
+			continue;
+		}
+
+		// Make sure we can damage this actor
+		if (!DamageSubsystem->IsDamageable(*HitActor))
+		{
+			continue;
+		}
 
-			// Make sure we can damage this actor
-			IDamageInterface* DamageableActor = Cast<IDamageInterface>(Hit.GetActor());
-			if (DamageableActor == nullptr)
+		// Already targeting this actor
+		if (OutTargets.ContainsByPredicate([HitActor](const FHitResult& Target) { return Target.GetActor() == HitActor; }))
+		{
+			continue;
+		}
+
+		// Narrow the sweep down to the close or far shape depending on how far along the hit is
+		if (!Hit.bStartPenetrating)
+		{
+			const FVector LocalHit = TraceRotation.UnrotateVector(Hit.ImpactPoint - Start);
+			const FVector& ShapeHalfSize = LocalHit.X < CloseRange ? CloseTraceHalfSize : FarTraceHalfSize;
+			if (FMath::Abs(LocalHit.Y) > ShapeHalfSize.Y || FMath::Abs(LocalHit.Z) > ShapeHalfSize.Z)
 			{
 				continue;
 			}
+		}
 
-			// Test if there's something blocking the shot between where we hit them
-			World->LineTraceSingleByChannel(BlockedHit, Start, Hit.Location, ECC_Camera, BlockedTraceParams);
-			if (BlockedHit.bBlockingHit)
-			{
-				if (BlockedHit.GetActor() != HitActor)
-				{
-					continue;
-				}
-			}
+		OutTargets.Add(Hit);
+	}
+}
 
-			// Do the damage
-			DamageParams.HitLocation = Hit.ImpactPoint;
-			DamageParams.HitNormal = Hit.Normal;
-			DamageableActor->RequestDamage(DamageParams);
+// Damage the targets found by a sweep that nothing is blocking the shot to
+void UWeaponRaycastComponent::DamageVisibleTargets(const TArray<FHitResult>& Hits, const FVector& Start, const FQuat& TraceRotation)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
 
-			// Give status effect
-			if (WeaponInfo->TimedStatusEffectClass != NULL)
-			{
-				UStatusEffectComponent* StatusEffectComponent = HitActor->FindComponentByClass<UStatusEffectComponent>();
-				if (StatusEffectComponent != nullptr)
-				{
-					FStatusEffectTimedRequest TimedRequest(WeaponInfo->TimedStatusEffectClass, WeaponInfo->TimedStatusEffectDuration);
-					StatusEffectComponent->AddStatusEffectTimed(TimedRequest);
-				}
-			}
+	TArray<FHitResult> Targets;
+	FindTargets(Hits, Start, TraceRotation, Targets);
 
-			// Store that we damaged this actor
-			HitActors.Add(HitActor);
-		}
-	};
+	// Test if there's something blocking the shot between where it was fired from and each target
+	const FCollisionQueryParams TraceParams = MakeTraceParams();
+	for (const FHitResult& Target : Targets)
+	{
+		FHitResult BlockingHit;
+		World->LineTraceSingleByChannel(BlockingHit, Start, Target.ImpactPoint, ECC_Camera, TraceParams);
+		DamageTarget(Target, BlockingHit);
+	}
+}
 
-	// Damage actors close and far
-	DamageHitActors(Hits);
-	DamageHitActors(FarHits);
+// Trace the line of sight to the targets found by a sweep without waiting on them, damaging the ones that are visible when they finish
+void UWeaponRaycastComponent::QueueVisibleTargetTraces(const TArray<FHitResult>& Hits, const FVector& Start, const FQuat& TraceRotation)
+{
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
 
-	// Spawn the VFX at the offset
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = Weapon;
-	SpawnParams.Instigator = static_cast<APawn*>(Wielder);
-	SpawnParams.bNoFail = true;
-	World->SpawnActor<AActor>(VFXClass, VFXTransform, SpawnParams);
+	TArray<FHitResult> Targets;
+	FindTargets(Hits, Start, TraceRotation, Targets);
 
-	return true;
+	const FCollisionQueryParams TraceParams = MakeTraceParams();
+	for (const FHitResult& Target : Targets)
+	{
+		FTraceHandle Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Target.ImpactPoint, ECC_Camera, TraceParams, FCollisionResponseParams::DefaultResponseParam, GetAsyncTraceDelegate());
+		QueueAsyncTrace(Handle, [this, Target](const TArray<FHitResult>& BlockingHits)
+		{
+			DamageTarget(Target, BlockingHits.Num() > 0 ? BlockingHits[0] : FHitResult(EForceInit::ForceInit));
+		});
+	}
+}
+
+// Damage a target if nothing but the target itself blocks the shot to it
+void UWeaponRaycastComponent::DamageTarget(const FHitResult& Target, const FHitResult& BlockingHit)
+{
+	AActor* TargetActor = Target.GetActor();
+	if (TargetActor == nullptr)
+	{
+		return;
+	}
+
+	if (BlockingHit.bBlockingHit && BlockingHit.GetActor() != TargetActor)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	ASSERT_RETURN(World != nullptr);
+
+	UDamageSubsystem* DamageSubsystem = World->GetSubsystem<UDamageSubsystem>();
+	ASSERT_RETURN(DamageSubsystem != nullptr);
+
+	// Setup damage params
+	FDamageRequestParams DamageParams;
+	DamageParams.bFromPlayer = URCStatics::IsActorPlayer(Wielder);
+	DamageParams.Damage = GetDamage();
+	DamageParams.DamageType = WeaponInfo->DamageType;
+	DamageParams.Instigator = Wielder;
+	DamageParams.CauseId = WeaponInfoId;
+	DamageParams.HitLocation = Target.ImpactPoint;
+	DamageParams.HitNormal = Target.Normal;
+
+	// Do the damage and give status effect
+	DamageSubsystem->QueueDamage(*TargetActor, DamageParams, WeaponInfo->TimedStatusEffectClass, WeaponInfo->TimedStatusEffectDuration);
 }
@@ -11,7 +11,7 @@
 /**
  *  Weapon that can fire and damage enemies with a raycast
  */
-UCLASS()
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class RC_API UWeaponRaycastComponent : public UWeaponComponent
 {
 	GENERATED_BODY()
@@ -36,11 +36,52 @@ private:
 	 */
 	bool ShootTowardsTarget(const FVector& TargetDirection);
 
-	// The half size of the close trace to create a cone
+	// Get the query params for the shot's traces, ignoring the weapon and its wielder
+	FCollisionQueryParams MakeTraceParams() const;
+
+	/**
+	 * Find the unique damageable actors within the close or far shape of a sweep
+	 * @param Hits				The hits of the sweep, sorted by distance
+	 * @param Start				Where the sweep started
+	 * @param TraceRotation		The rotation of the sweep's shape
+	 * @param OutTargets		The closest hit on each actor found, at most MaxOcclusionTraces of them
+	 */
+	void FindTargets(const TArray<FHitResult>& Hits, const FVector& Start, const FQuat& TraceRotation, TArray<FHitResult>& OutTargets);
+
+	/**
+	 * Damage the targets found by a sweep that nothing is blocking the shot to
+	 * @param Hits				The hits of the sweep, sorted by distance
+	 * @param Start				Where the sweep started
+	 * @param TraceRotation		The rotation of the sweep's shape
+	 */
+	void DamageVisibleTargets(const TArray<FHitResult>& Hits, const FVector& Start, const FQuat& TraceRotation);
+
+	/**
+	 * Trace the line of sight to the targets found by a sweep without waiting on them, damaging the ones that are visible when they finish
+	 * @param Hits				The hits of the sweep, sorted by distance
+	 * @param Start				Where the sweep started
+	 * @param TraceRotation		The rotation of the sweep's shape
+	 */
+	void QueueVisibleTargetTraces(const TArray<FHitResult>& Hits, const FVector& Start, const FQuat& TraceRotation);
+
+	/**
+	 * Damage a target if nothing but the target itself blocks the shot to it
+	 * @param Target			The sweep's hit on the target
+	 * @param BlockingHit		The result of the line trace from where the shot was fired to the target
+	 */
+	void DamageTarget(const FHitResult& Target, const FHitResult& BlockingHit);
+
+	// Max targets a single shot checks line of sight to
+	static const int32 MaxOcclusionTraces;
+
+	// Fraction of the range that the close trace shape is used for
+	static const float CloseTraceRangeFraction;
+
+	// The half size of the trace for close hits to create a cone
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
 	FVector CloseTraceHalfSize;
 
-	// The half size of the far trace to create a cone
+	// The half size of the trace for far hits to create a cone
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Weapon, meta = (AllowPrivateAccess = "true"))
 	FVector FarTraceHalfSize;
 
@@ -50,7 +91,4 @@ private:
 	// The VFX class to spawn when shot
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile, Meta = (AllowPrivateAccess = "True"))
 	TSubclassOf<class AActor> VFXClass;
-
-	// Reference to the mesh of the weapon
-	const class USkeletalMeshComponent* WeaponMesh = nullptr;
 };
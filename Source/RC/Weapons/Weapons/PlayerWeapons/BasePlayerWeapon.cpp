@@ -2,7 +2,9 @@
 
 #include "BasePlayerWeapon.h"
 
+#include "Components/SkeletalMeshComponent.h"
 #include "Curves/CurveFloat.h"
+#include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/SkeletalMeshSocket.h"
 
@@ -14,6 +16,18 @@
 #include "RC/Util/RCTypes.h"
 #include "RC/Weapons/Bullets/BaseBullet.h"
 #include "RC/Weapons/Weapons/Components/WeaponComponent.h"
+#include "RC/Weapons/Weapons/Components/WeaponProjectileComponent.h"
+
+#if DEBUG_ENABLED
+static TAutoConsoleVariable<bool> CTrajectoryDebugDisplay(
+	TEXT("Weapon.TrajectoryDebugDisplay"),
+	false,
+	TEXT("Toggle the trajectory preview debug display.\n")
+	TEXT("0: Don't display debug info (default)\n")
+	TEXT("1: Display debug info"),
+	ECVF_Default
+	);
+#endif
 
 // After properties have been loaded
 void ABasePlayerWeapon::PostInitProperties()
@@ -24,6 +38,17 @@ void ABasePlayerWeapon::PostInitProperties()
 	ASSERT(PlayerWeaponInfo != nullptr || HasAnyFlags(RF_ClassDefaultObject) || GetWorld() == nullptr || (GetWorld()->WorldType != EWorldType::Game && GetWorld()->WorldType != EWorldType::PIE));
 }
 
+// Called each frame
+void ABasePlayerWeapon::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bShowingTrajectory)
+	{
+		UpdateTrajectoryPreview();
+	}
+}
+
 // Get the player weapon info
 const UPlayerWeaponInfo* ABasePlayerWeapon::GetPlayerWeaponInfo() const
 {
@@ -82,6 +107,29 @@ void ABasePlayerWeapon::SetWielder(ARCCharacter* NewWielder)
 	RecomputeDamage();
 }
 
+// Show or hide the weapon when it's equipped or put away
+void ABasePlayerWeapon::SetEquipped(bool bEquipped)
+{
+	if (!bEquipped)
+	{
+		// Let go of the trigger so it doesn't keep firing while put away and can be pulled again when re-equipped
+		UpdateTriggerStatus(ETriggerStatus::NONE);
+		StopWielderAttackMontage();
+	}
+
+	SetActorHiddenInGame(!bEquipped);
+	SetActorEnableCollision(bEquipped);
+	SetActorTickEnabled(bEquipped);
+	if (Mesh != nullptr)
+	{
+		Mesh->SetComponentTickEnabled(bEquipped);
+	}
+	if (WeaponComponent != nullptr)
+	{
+		WeaponComponent->SetComponentTickEnabled(bEquipped);
+	}
+}
+
 // Get the current ammo 
 int ABasePlayerWeapon::GetCurrentAmmo() const
 {
@@ -107,6 +155,13 @@ void ABasePlayerWeapon::UpdateTriggerStatus(const ETriggerStatus& NewTriggerStat
 	ETriggerStatus PreviousStatus = CurrentTriggerStatus;
 	CurrentTriggerStatus = NewTriggerStatus;
 
+	// Stop showing the arc once the trigger isn't half pulled
+	if (bShowingTrajectory && CurrentTriggerStatus != ETriggerStatus::HALF)
+	{
+		bShowingTrajectory = false;
+		TrajectoryPreview.Reset();
+	}
+
 	OnTriggerStatusUpdated(PreviousStatus);
 
 	PerformTriggerAction();
@@ -166,10 +221,57 @@ bool ABasePlayerWeapon::PerformFullTrigger()
 // Perform an action when the trigger is held halfway
 bool ABasePlayerWeapon::PerformHalfTrigger()
 {
+	// Show where the projectile would land
+	if (!bShowingTrajectory && PlayerWeaponInfo != nullptr && PlayerWeaponInfo->bShowTrajectoryOnHalfTrigger)
+	{
+		bShowingTrajectory = true;
+		UpdateTrajectoryPreview();
+	}
+
 	PlayerAttackDelegate.Broadcast(this, ETriggerStatus::HALF);
 	return true;
 }
 
+// Get the predicted arc of the projectile shown while the trigger is half pulled
+bool ABasePlayerWeapon::GetTrajectoryPreview(TArray<FVector>& OutPoints, FVector& OutImpactPoint) const
+{
+	OutPoints = TrajectoryPreview.GetPoints();
+	if (TrajectoryPreview.HasImpact())
+	{
+		OutImpactPoint = TrajectoryPreview.GetImpact().Location;
+	}
+	else
+	{
+		OutImpactPoint = OutPoints.Num() != 0 ? OutPoints.Last() : FVector::ZeroVector;
+	}
+	return bShowingTrajectory;
+}
+
+// Update the predicted arc of the projectile while it's being shown
+void ABasePlayerWeapon::UpdateTrajectoryPreview()
+{
+	UWeaponProjectileComponent* ProjectileWeaponComponent = Cast<UWeaponProjectileComponent>(WeaponComponent);
+	ASSERT_RETURN(ProjectileWeaponComponent != nullptr, "Weapon %s shows its trajectory but doesn't shoot projectiles", *GetName());
+
+	ProjectileWeaponComponent->UpdateTrajectoryPreview(TrajectoryPreview);
+
+#if DEBUG_ENABLED && ENABLE_DRAW_DEBUG
+	if (CTrajectoryDebugDisplay.GetValueOnGameThread())
+	{
+		const TArray<FVector>& Points = TrajectoryPreview.GetPoints();
+		for (int32 PointIndex = 1; PointIndex < Points.Num(); ++PointIndex)
+		{
+			DrawDebugLine(GetWorld(), Points[PointIndex - 1], Points[PointIndex], FColor::Cyan);
+		}
+
+		if (TrajectoryPreview.HasImpact())
+		{
+			DrawDebugPoint(GetWorld(), TrajectoryPreview.GetImpact().Location, 20, FColor::Red);
+		}
+	}
+#endif
+}
+
 // Called when the cooldown has ended
 void ABasePlayerWeapon::CooldownEnded()
 {
@@ -241,39 +343,41 @@ bool ABasePlayerWeapon::CanLevelUp() const
 // Called when XP has been applied to the weapon data
 void ABasePlayerWeapon::OnXPGained(float XP)
 {
-	XPGainedDelegate.Broadcast(this, PlayerWeaponData->CurrentXP, GetXPTotalForNextLevel());
+	// Gain as many levels as the XP allows
+	const uint8 PreviousLevel = GetCurrentLevel();
+	while (CanLevelUp())
+	{
+		// A bad level config would otherwise never stop
+		if (!LevelUp())
+		{
+			break;
+		}
+	}
 
-	if (CanLevelUp())
+	if (GetCurrentLevel() != PreviousLevel)
 	{
-		LevelUp();
+		RecomputeDamage();
+		LevelUpDelegate.Broadcast(this, GetCurrentLevel());
 	}
+
+	XPGainedDelegate.Broadcast(this, PlayerWeaponData->CurrentXP, GetXPTotalForNextLevel());
 }
 
-// Level up the weapon
-void ABasePlayerWeapon::LevelUp()
+// Level up the weapon once
+bool ABasePlayerWeapon::LevelUp()
 {
-	ASSERT_RETURN(PlayerWeaponInfo != nullptr);
-	ASSERT_RETURN(PlayerWeaponData != nullptr);
+	ASSERT_RETURN_VALUE(PlayerWeaponInfo != nullptr, false);
+	ASSERT_RETURN_VALUE(PlayerWeaponData != nullptr, false);
 
 	// Increment level
 	PlayerWeaponData->CurrentLevelIndex += 1;
 
 	const FWeaponLevelInfo* LevelInfo = GetCurrentLevelData();
-	ASSERT_RETURN(LevelInfo != nullptr);
+	ASSERT_RETURN_VALUE(LevelInfo != nullptr, false);
 
-	// Remove XP that was required and maybe level up again
+	// Remove XP that was required
 	PlayerWeaponData->CurrentXP -= LevelInfo->XPNeeded;
 	PlayerWeaponData->CurrentXP = FMath::Max(PlayerWeaponData->CurrentXP, 0.0f);
 	PlayerWeaponData->XPTotalForNextLevel = GetCurrentLevel() >= UPlayerWeaponInfo::MAX_LEVELS ? 0 : PlayerWeaponInfo->WeaponLevelConfigs[GetCurrentLevel()].XPNeeded;
-
-	// Update damage
-	RecomputeDamage();
-
-	// Execute delegate
-	LevelUpDelegate.Broadcast(this, GetCurrentLevel());
-
-	if (CanLevelUp())
-	{
-		LevelUp();
-	}
+	return true;
 }
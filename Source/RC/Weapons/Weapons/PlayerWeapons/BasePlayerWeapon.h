@@ -6,6 +6,7 @@
 
 #include "RC/Weapons/RCWeaponTypes.h"
 #include "RC/Weapons/Weapons/BaseWeapon.h"
+#include "RC/Weapons/Weapons/TrajectoryPreview.h"
 
 #include "BasePlayerWeapon.generated.h"
 
@@ -28,6 +29,9 @@ class RC_API ABasePlayerWeapon : public ABaseWeapon
 	GENERATED_BODY()
 
 public:
+	// Called each frame
+	void Tick(float DeltaTime) override;
+
 	// Get the player weapon info
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	const UPlayerWeaponInfo* GetPlayerWeaponInfo() const;
@@ -41,6 +45,13 @@ public:
 	 */
 	void SetWielder(class ARCCharacter* NewWielder);
 
+	/**
+	 * Show and start ticking the weapon when it's equipped, or hide it and let go of the trigger when it's put away.
+	 * The weapon stays spawned while put away so swapping back to it keeps its state
+	 * @param bEquipped	Whether the weapon is now equipped
+	 */
+	void SetEquipped(bool bEquipped);
+
 	/**
 	 * Update the trigger status. Possibly start shooting
 	 * @param NewTriggerStatus	The status of the trigger to update to
@@ -78,6 +89,16 @@ public:
 	// Get the Attack delegate
 	FOnPlayerWeaponAttack& OnPlayerWeaponAttack() { return PlayerAttackDelegate; }
 
+	/**
+	 * Get the predicted arc of the projectile shown while the trigger is half pulled
+	 *
+	 * @param OutPoints			Points along the arc, ending at the impact if there is one
+	 * @param OutImpactPoint	Where the arc hits something, or the end of the arc if it doesn't
+	 * Returns whether the arc is being shown
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weapon")
+	bool GetTrajectoryPreview(TArray<FVector>& OutPoints, FVector& OutImpactPoint) const;
+
 protected:
 	friend UPlayerWeaponData;
 
@@ -124,13 +145,19 @@ protected:
 	bool CanLevelUp() const;
 
 	/**
-	 * Called when XP has been applied to the weapon data
+	 * Called when XP has been applied to the weapon data. Gains every level the XP allows before letting anyone know
 	 * @param XP	The XP that was gained
 	 */
 	void OnXPGained(float XP);
 
-	// Level up the weapon
-	void LevelUp();
+	/**
+	 * Level up the weapon once, leaving updating the damage and letting anyone know to OnXPGained
+	 * Returns false if the weapon couldn't level up
+	 */
+	bool LevelUp();
+
+	// Update the predicted arc of the projectile while it's being shown
+	void UpdateTrajectoryPreview();
 
 	// Whether the weapon is currently shooting
 	UPROPERTY(Category = Weapon, VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
@@ -154,4 +181,10 @@ private:
 	// Broadcasted when the player weapon attacks
 	UPROPERTY(BlueprintAssignable, Category = Weapon, meta = (AllowPrivateAccess))
 	FOnPlayerWeaponAttack PlayerAttackDelegate;
+
+	// The predicted arc of the projectile
+	FTrajectoryPreview TrajectoryPreview;
+
+	// Whether the predicted arc is being shown
+	bool bShowingTrajectory = false;
 };
@@ -17,10 +17,11 @@ AWrench::AWrench()
 	WeaponComponent = CreateDefaultSubobject<UWeaponMeleeComponent>(TEXT("Weapon"));
 
 	/* MOVE TO MELEE COMPONENT */
-	// Create the trigger to detect hitting
+	// Create the trigger to detect hitting. The melee component sweeps its shape, so it doesn't need collision itself
 	HitTrigger = CreateDefaultSubobject<UCapsuleComponent>(TEXT("HitTrigger"));
 	HitTrigger->SetCollisionProfileName(URCStatics::OverlapOnlyActor_ProfileName);
-	HitTrigger->SetGenerateOverlapEvents(true);
+	HitTrigger->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	HitTrigger->SetGenerateOverlapEvents(false);
 	HitTrigger->CanCharacterStepUpOn = ECanBeCharacterBase::ECB_No;
 	HitTrigger->SetupAttachment(Mesh);
 }
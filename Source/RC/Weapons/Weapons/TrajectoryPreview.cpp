@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "TrajectoryPreview.h"
+
+#include "Engine/World.h"
+
+#include "RC/Debug/Debug.h"
+
+const float FTrajectoryPreview::SegmentTime = 0.05f;
+const int32 FTrajectoryPreview::MaxSegments = 40;
+const int32 FTrajectoryPreview::MaxTracesPerFrame = 8;
+const float FTrajectoryPreview::ReuseTolerance = 5.0f;
+
+// Update the arc for a new launch
+void FTrajectoryPreview::Update(const UWorld& World, const FVector& Start, const FVector& Velocity, float GravityZ, float Radius, ECollisionChannel Channel, const FCollisionQueryParams& Params, const FCollisionResponseParams& ResponseParams)
+{
+	Segments.SetNum(MaxSegments);
+
+	// The arc stops at the first segment that hit something, so the segments past it don't need tracing
+	int32 NumSegments = MaxSegments;
+	for (int32 SegmentIndex = 0; SegmentIndex < MaxSegments; ++SegmentIndex)
+	{
+		if (Segments[SegmentIndex].bTraced && Segments[SegmentIndex].bHit)
+		{
+			NumSegments = SegmentIndex + 1;
+			break;
+		}
+	}
+
+	// Segments that moved are traced again while there's budget, otherwise the last result is used until they're caught up.
+	// The budget carries on from where it ran out last frame so every segment gets its turn
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(Radius);
+	int32 TracesLeft = MaxTracesPerFrame;
+	for (int32 Step = 0; Step < NumSegments && TracesLeft > 0; ++Step)
+	{
+		const int32 SegmentIndex = (NextTraceSegment + Step) % NumSegments;
+		const FVector SegmentStart = GetLocationAtTime(Start, Velocity, GravityZ, SegmentIndex * SegmentTime);
+		const FVector SegmentEnd = GetLocationAtTime(Start, Velocity, GravityZ, (SegmentIndex + 1) * SegmentTime);
+
+		FSegment& Segment = Segments[SegmentIndex];
+		const bool bMoved = !Segment.bTraced || !Segment.Start.Equals(SegmentStart, ReuseTolerance) || !Segment.End.Equals(SegmentEnd, ReuseTolerance);
+		if (bMoved)
+		{
+			--TracesLeft;
+			Segment.Start = SegmentStart;
+			Segment.End = SegmentEnd;
+			Segment.bHit = World.SweepSingleByChannel(Segment.Hit, SegmentStart, SegmentEnd, FQuat::Identity, Channel, Shape, Params, ResponseParams);
+			Segment.bTraced = true;
+			NextTraceSegment = SegmentIndex + 1;
+		}
+	}
+
+	// Follow the arc up to the first segment that hits something
+	Points.Reset();
+	Points.Add(Start);
+	ImpactSegment = INDEX_NONE;
+	for (int32 SegmentIndex = 0; SegmentIndex < MaxSegments; ++SegmentIndex)
+	{
+		const FSegment& Segment = Segments[SegmentIndex];
+		if (Segment.bTraced && Segment.bHit)
+		{
+			Points.Add(Segment.Hit.Location);
+			ImpactSegment = SegmentIndex;
+			return;
+		}
+
+		Points.Add(GetLocationAtTime(Start, Velocity, GravityZ, (SegmentIndex + 1) * SegmentTime));
+	}
+}
+
+// Forget the arc and every cached trace
+void FTrajectoryPreview::Reset()
+{
+	Segments.Reset();
+	Points.Reset();
+	ImpactSegment = INDEX_NONE;
+	NextTraceSegment = 0;
+}
+
+// Get where the arc hits
+const FHitResult& FTrajectoryPreview::GetImpact() const
+{
+	static const FHitResult NoImpact;
+	ASSERT_RETURN_VALUE(ImpactSegment != INDEX_NONE, NoImpact);
+	return Segments[ImpactSegment].Hit;
+}
+
+// Get where the projectile is along the arc
+FVector FTrajectoryPreview::GetLocationAtTime(const FVector& Start, const FVector& Velocity, float GravityZ, float Time)
+{
+	return Start + Velocity * Time + FVector(0, 0, 0.5f * GravityZ * Time * Time);
+}
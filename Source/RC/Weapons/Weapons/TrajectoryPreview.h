@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+
+/**
+ * The predicted arc of a thrown projectile, for showing where it will land before it's thrown.
+ * The arc is solved analytically and traced a segment at a time. Segments that barely moved since they were last traced keep their result,
+ * and only a limited number of segments are traced each frame, taking turns, so the rest catch up over the next frames
+ */
+class RC_API FTrajectoryPreview
+{
+public:
+	/**
+	 * Update the arc for a new launch
+	 *
+	 * @param World				The world to trace in
+	 * @param Start				Where the projectile is launched from
+	 * @param Velocity			The velocity the projectile is launched at
+	 * @param GravityZ			Gravity applied to the projectile
+	 * @param Radius			Radius of the projectile
+	 * @param Channel			The collision channel of the projectile
+	 * @param Params			Params of the traces
+	 * @param ResponseParams	What the projectile collides with
+	 */
+	void Update(const UWorld& World, const FVector& Start, const FVector& Velocity, float GravityZ, float Radius, ECollisionChannel Channel, const FCollisionQueryParams& Params, const FCollisionResponseParams& ResponseParams);
+
+	// Forget the arc and every cached trace
+	void Reset();
+
+	// Get the points along the arc, ending at the impact if there is one
+	const TArray<FVector>& GetPoints() const { return Points; }
+
+	// Whether the arc hits something
+	bool HasImpact() const { return ImpactSegment != INDEX_NONE; }
+
+	// Get where the arc hits, only valid if it has an impact
+	const FHitResult& GetImpact() const;
+
+private:
+	/**
+	 * A piece of the arc that is traced on its own
+	 */
+	struct FSegment
+	{
+		// Where the segment started when it was last traced
+		FVector Start = FVector::ZeroVector;
+
+		// Where the segment ended when it was last traced
+		FVector End = FVector::ZeroVector;
+
+		// The blocking hit of the last trace
+		FHitResult Hit;
+
+		// Whether the segment has been traced
+		bool bTraced = false;
+
+		// Whether the last trace hit something
+		bool bHit = false;
+	};
+
+	/**
+	 * Get where the projectile is along the arc
+	 *
+	 * @param Start		Where the projectile is launched from
+	 * @param Velocity	The velocity the projectile is launched at
+	 * @param GravityZ	Gravity applied to the projectile
+	 * @param Time		Time in seconds since the launch
+	 * Returns the location at the time
+	 */
+	static FVector GetLocationAtTime(const FVector& Start, const FVector& Velocity, float GravityZ, float Time);
+
+	// Time in seconds the projectile travels through each segment
+	static const float SegmentTime;
+
+	// Number of segments the arc is broken into
+	static const int32 MaxSegments;
+
+	// Most segments traced each frame
+	static const int32 MaxTracesPerFrame;
+
+	// How far a segment can move before it's traced again
+	static const float ReuseTolerance;
+
+	// Segments of the arc, in order from the launch
+	TArray<FSegment> Segments;
+
+	// Points along the arc
+	TArray<FVector> Points;
+
+	// Index of the segment that hits something
+	int32 ImpactSegment = INDEX_NONE;
+
+	// Index of the segment to start tracing from next frame
+	int32 NextTraceSegment = 0;
+};